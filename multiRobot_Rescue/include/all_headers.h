@@ -4,14 +4,29 @@
 // Core configuration
 #include "config.h"
 
+// Random number generation
+#include "rng.h"
+
 // Grid management
 #include "grid.h"
 
 // Pathfinding
 #include "astar.h"
+#include "path_service.h"
+#include "dda.h"
 
 // Genetic algorithm
 #include "ga.h"
+#include "island.h"
+#include "steady.h"
+#include "anytime.h"
+#include "thread_pool.h"
+#include "cpuset.h"
+#include "cost_table.h"
+#include "memetic.h"
+#include "seeding.h"
+#include "tour.h"
+#include "net_eval.h"
 
 // Visualization
 #include "visualize.h"
@@ -19,6 +34,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <time.h>
 #include <limits.h>
 #include <math.h>
@@ -27,8 +43,18 @@
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <fcntl.h>
-#include <semaphore.h>
+#include <dirent.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <pthread.h>
 #include <sys/wait.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/prctl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
 #include <signal.h>
 #include <errno.h>
 #include <GL/glut.h>
@@ -0,0 +1,65 @@
+#ifndef ANYTIME_H
+#define ANYTIME_H
+
+#include "ga.h"
+#include "config.h"
+
+/**
+ * Best-plan slot.
+ *
+ * Holds a private copy of the best chromosome found so far. The evolution
+ * engine is the single writer; any other thread can take a consistent
+ * snapshot at any time without blocking the writer (seqlock).
+ */
+typedef struct {
+    unsigned int seq;           // odd while a publish is in progress
+    int generation;             // generation that produced the plan
+    double published_at;        // monotonic_seconds() when the plan arrived
+    int valid;                  // 0 until the first publish
+    int robot_count;
+    int max_survivors_per_robot;
+    Chromosome *plan;
+} BestPlanSlot;
+
+int best_plan_init(BestPlanSlot *slot, int robot_count, int max_survivors_per_robot);
+void best_plan_free(BestPlanSlot *slot);
+
+// Copies c into the slot if it is fitter than the plan already held
+void best_plan_publish(BestPlanSlot *slot, const Chromosome *c, int generation);
+
+// Copies the current plan into out (allocated like a population member);
+// returns 0 if nothing has been published yet. generation and published_at
+// may be NULL.
+int best_plan_read(BestPlanSlot *slot, Chromosome *out, int *generation, double *published_at);
+
+// Slot the engines publish into; NULL (the default) disables publishing
+void ga_set_best_plan_slot(BestPlanSlot *slot);
+void ga_publish_best(const Chromosome *c, int generation);
+
+/**
+ * Early-stop criteria shared by the engines: TIME_BUDGET_MS wall clock,
+ * STAGNATION_GENERATIONS without improvement, and MIN_DIVERSITY (fraction of
+ * distinct chromosomes in the population).
+ */
+typedef struct {
+    double deadline;            // CLOCK_MONOTONIC seconds, 0 = no time budget
+    int stagnation_limit;
+    double min_diversity;
+    double best_fitness;
+    int last_improvement;       // generation of the last best-fitness gain
+    uint64_t *hashes;           // diversity scratch, one per individual
+    int hash_capacity;
+} StopCriteria;
+
+// The deadline is counted from this call
+void stop_criteria_init(StopCriteria *sc, const Config *cfg);
+void stop_criteria_free(StopCriteria *sc);
+
+// Returns a short reason once evolution should stop, NULL otherwise.
+// pop must be sorted best first.
+const char *stop_criteria_check(StopCriteria *sc, const Chromosome pop[], int pop_size,
+                                int robot_count, int generation);
+
+double monotonic_seconds(void);
+
+#endif
@@ -1,6 +1,41 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+// Evolution engines selectable with GA_ENGINE
+typedef enum {
+    GA_ENGINE_GENERATIONAL = 0,  // single population, parallel evaluation
+    GA_ENGINE_ISLAND,            // forked islands with periodic migration
+    GA_ENGINE_STEADY,            // steady-state, breeding overlaps evaluation
+    GA_ENGINE_PIPELINED          // generational, next generation bred while this one is scored
+} GaEngine;
+
+// Where the generational engine evaluates fitness (EVAL_BACKEND)
+typedef enum {
+    EVAL_BACKEND_PROCESS = 0,    // POOL_SIZE forked workers fed through shared memory
+    EVAL_BACKEND_THREAD,         // in-process work-stealing threads, one per usable CPU
+    EVAL_BACKEND_TCP             // evaluator daemons over TCP, the process pool as fallback
+} EvalBackend;
+
+// Chromosome encodings selectable with ENCODING
+typedef enum {
+    ENCODING_MISSIONS = 0,       // per-robot survivor sequences, repaired after each operator
+    ENCODING_GIANT_TOUR          // one survivor permutation, split optimally into missions
+} Encoding;
+
+// Where LOCAL_SEARCH applies the memetic improvement step
+typedef enum {
+    LOCAL_SEARCH_OFF = 0,
+    LOCAL_SEARCH_ELITES = 1,     // elites carried into each generation
+    LOCAL_SEARCH_CHILDREN = 2,   // every child after mutation
+    LOCAL_SEARCH_ALL = 3         // both
+} LocalSearchMode;
+
+// Island migration topologies selectable with MIGRATION_TOPOLOGY
+typedef enum {
+    MIGRATION_RING = 0,          // island i receives from island i-1
+    MIGRATION_RANDOM             // each migration picks a random source island
+} MigrationTopology;
+
 typedef struct {
     // Grid
     int grid_x, grid_y, grid_z;
@@ -18,8 +53,37 @@ typedef struct {
     int generations;
     double mutation_rate;
     int elitism_percent;
-    int pool_size;
+    int pool_size;                // Fitness worker processes (0 = sized from CPUs and measured cost)
+    int pool_max;                 // Upper bound on workers or evaluator threads (0 = none)
+    int pin_workers;              // 1 = pin each worker process to its own CPU
+    int eval_backend;             // EvalBackend
+    char evaluator_hosts[192];    // host:port,... of evaluator daemons (EVAL_BACKEND = tcp)
+    int evaluator_spawn_local;    // Evaluator daemons forked on 127.0.0.1 (EVAL_BACKEND = tcp)
+    int breed_threads;            // Threads for selection/crossover/mutation (0 = one per CPU)
+    int ga_engine;                // GaEngine
+    int encoding;                 // Encoding
+    
+    // Island model
+    int island_count;             // Islands (forked processes), 0 = one per CPU
+    int migration_interval;       // Generations between migrations
+    int migration_size;           // Best individuals sent per migration
+    int migration_topology;       // MigrationTopology
     int max_survivors_per_robot;  // Maximum survivors each robot can rescue
+    int fitness_cache_size;       // Fitness memoization entries (0 = disabled)
+    int seed_nearest_percent;     // Initial population share per seeding heuristic;
+    int seed_sweep_percent;       // the rest is seeded randomly
+    int seed_regret_percent;
+    int local_search;             // LocalSearchMode
+    int local_search_moves;       // Improving moves per individual (0 = until none left)
+    int exact_top_k;              // Best individuals rescored with exact paths each generation (0 = estimate only)
+    
+    // Anytime mode (0 disables each criterion)
+    int time_budget_ms;           // Wall-clock budget for evolution
+    int stagnation_generations;   // Stop after this many generations without improvement
+    double min_diversity;         // Stop when distinct individuals fall below this fraction
+
+    // Reproducibility
+    unsigned long long random_seed;  // Run-level PRNG seed (0 = derive from time)
 } Config;
 
 int load_config(const char *filename, Config *cfg);
@@ -0,0 +1,37 @@
+#ifndef COST_TABLE_H
+#define COST_TABLE_H
+
+#include "ga.h"
+#include "config.h"
+
+/**
+ * Visit value table.
+ *
+ * value[r * survivor_count + sid] is fitness_visit_value() of survivor sid
+ * from robot r's base. Missions are round trips, so a chromosome's path
+ * terms are the sum of its visits and any reassignment can be scored from
+ * the table alone. Built once per run and read-only afterwards; local
+ * search and the giant-tour split share it.
+ */
+typedef struct {
+    int robot_count;
+    int survivor_count;
+    Node *bases;        // robot_pos each row was computed for
+    double *value;      // [r * survivor_count + sid]
+    int *ranked;        // [r * survivor_count + k], sids by descending value
+} CostTable;
+
+// Builds the table for the bases in reference and survivors
+// [0, survivor_count). A no-op if it already matches. Call before any
+// thread reads the table.
+int cost_table_init(const Chromosome *reference, int robot_count, int survivor_count,
+                    const Config *cfg);
+void cost_table_free(void);
+
+// NULL until cost_table_init() succeeded
+const CostTable *cost_table_get(void);
+
+// 1 if every mission of c starts at the base its table row was built for
+int cost_table_matches(const CostTable *ct, const Chromosome *c, int robot_count);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef CPUSET_H
+#define CPUSET_H
+
+/**
+ * CPUs this process may run on, from sched_getaffinity.
+ *
+ * cpuset_list() orders them for pinning workers: the CPUs of the NUMA node
+ * the caller runs on come first, then the other nodes in node order, so a
+ * pool smaller than the machine stays next to the memory the master touched.
+ * Without /sys/devices/system/node the affinity order is kept.
+ */
+
+// CPUs in the affinity mask, at least 1
+int cpuset_available(void);
+
+// Writes up to max CPU ids to cpus[] in pinning order; returns how many
+int cpuset_list(int cpus[], int max);
+
+// Pins the calling thread to one CPU; 0 on success
+int cpuset_pin(int cpu);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef DDA_H
+#define DDA_H
+
+#include "astar.h"
+#include "config.h"
+
+/**
+ * Voxel traversal along straight segments (Amanatides & Woo).
+ *
+ * Walks from the centre of voxel a to the centre of voxel b in integer
+ * arithmetic and visits every voxel the segment passes through exactly
+ * once. Where the segment crosses an edge or a corner the axes step one at
+ * a time (x, then y, then z), so the walk is 6-connected like robot moves
+ * and covers 1 + |dx| + |dy| + |dz| voxels. Endpoints are clamped to the
+ * grid. Reads the packed voxels array when it exists, building otherwise.
+ */
+typedef struct {
+    int cells;       // voxels visited, both endpoints included
+    int obstacles;   // visited voxels that are obstacles
+    int risk;        // summed risk level of the visited voxels
+} SegmentTrace;
+
+// Segments advanced together by dda_trace_batch
+#define DDA_LANES 8
+
+void dda_trace(Node a, Node b, const Config *cfg, SegmentTrace *out);
+
+// Traces a[i] -> b[i] for i in [0, count). Groups of DDA_LANES segments
+// step in lockstep over structure-of-arrays state with branch-free axis
+// selection, so the stepping vectorizes and only the voxel loads are
+// gathers. Same results as calling dda_trace on each segment.
+void dda_trace_batch(const Node a[], const Node b[], int count, const Config *cfg,
+                     SegmentTrace out[]);
+
+#endif
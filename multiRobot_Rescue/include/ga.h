@@ -2,8 +2,11 @@
 #ifndef GA_H
 #define GA_H
 
+#include <stdint.h>
+
 #include "astar.h"
 #include "config.h"
+#include "rng.h"
 
 
 // Robot mission structure - stores sequence of survivors to rescue
@@ -13,42 +16,132 @@ typedef struct {
     int survivor_count;                // Number of survivors assigned (limited by cfg->max_survivors_per_robot at runtime)
 } RobotMission;
 
+// Partial fitness terms of one robot mission, cached between evaluations
+typedef struct {
+    double length;      // estimated round-trip path length for the mission
+    double risk;        // risk sampled along those paths
+    int valid_paths;    // survivors reachable from the robot's start
+    int dirty;          // 1 = mission changed since these terms were computed
+} MissionScore;
+
+// How a chromosome's fitness was scored; higher is more accurate
+typedef enum {
+    FIDELITY_ESTIMATE = 0,   // straight-line path cost estimate (voxel traversal)
+    FIDELITY_EXACT           // shortest-path lengths from the path service
+} FitnessFidelity;
+
 typedef struct {
     RobotMission *missions;  // dynamically allocated: one per robot
+    MissionScore *scores;    // one per mission, recomputed only when dirty
+    int *tour;               // giant-tour genotype (tour.h), NULL with the mission encoding
+    int tour_length;
     double fitness;
+    int fitness_valid;       // 1 = fitness matches the current genes
+    int fidelity;            // FitnessFidelity of fitness
 } Chromosome;
 
+// Read-only genes of one chromosome in flat arrays, as the process pool lays
+// them out in shared memory: robot r starts at robot_pos[r] and visits
+// sequences[r * stride .. r * stride + survivor_counts[r] - 1]
+typedef struct {
+    const Node *robot_pos;
+    const int *survivor_counts;
+    const int *sequences;
+    int stride;              // sequence slots per robot (max_survivors_per_robot)
+} ChromosomeView;
+
+// Fitness memoization counters of the most recent compute_fitness_parallel_mp call
+typedef struct {
+    int total;          // chromosomes in the population
+    int reused;         // fitness still valid from the previous generation (elites)
+    int cache_hits;     // found in the fitness cache or duplicated within the batch
+    int evaluated;      // actually dispatched for evaluation
+} FitnessCacheStats;
+
 Chromosome *allocate_population(int pop_size, int robot_count, int max_survivors_per_robot);
 void free_population(Chromosome *pop, int pop_size, int robot_count);
+void copy_chromosome(Chromosome *dst, const Chromosome *src, int robot_count, int max_survivors_per_robot);
 
 void seed_population(Chromosome pop[], int pop_size,
                      const Node robot_starts[], int robot_count,
                      const Survivor survivors[], int survivor_count,
-                     const Config *cfg);
+                     const Config *cfg, Rng *rng);
 
 double fitness_chromosome(const Chromosome *c, int robot_count, const Config *cfg);
+// Same result as fitness_chromosome, but only rescores dirty missions and caches them
+double fitness_chromosome_cached(Chromosome *c, int robot_count, const Config *cfg);
+// fitness_chromosome_cached on a view: rescores dirty scores[] in place, no copies
+double fitness_view_cached(const ChromosomeView *v, MissionScore scores[], int robot_count,
+                           const Config *cfg);
+// Same terms as fitness_chromosome, with exact path lengths (path_service.h)
+double fitness_chromosome_exact(const Chromosome *c, int robot_count, const Config *cfg);
+// Rescores the top_k best estimates of a sorted population and every elite
+// with exact path lengths and re-sorts it. Returns the number rescored.
+int fitness_refine_top(Chromosome pop[], int pop_size, int top_k, int elite_count,
+                       int robot_count, const Config *cfg);
 int detect_collisions(const Chromosome *c, int robot_count);
 
+// Lists the survivors the fitness kernel scores against. Call once after the
+// grid is final and before any evaluation or worker starts.
+void fitness_survivors_init(const Config *cfg);
+// Survivors known to the fitness kernel (sids index this table)
+int fitness_survivor_total(void);
+// Fitness contribution of one visit to survivor sid from base. Missions are
+// round trips, so a chromosome's path terms are the sum of its visits.
+double fitness_visit_value(Node base, int sid, const Config *cfg);
+
+// 64-bit hash of the canonical gene layout (start, count and sequence per robot)
+uint64_t chromosome_hash(const Chromosome *c, int robot_count);
+
 void compute_fitness_parallel_mp(Chromosome pop[], int pop_size, int robot_count, const Config *cfg,
                                   const Node robot_starts[], const Survivor survivors[], int survivor_count);
-int init_process_pool(int max_pop_size, int robot_count, int max_survivor_count, int pool_size, int max_survivors_per_robot);
+// compute_fitness_parallel_mp in two halves. begin starts the batch on the
+// process pool and returns, so the caller can work while it is scored;
+// finish waits for it and publishes the fitness. One batch at a time; other
+// backends score the whole batch inside begin.
+void fitness_batch_begin(Chromosome pop[], int pop_size, int robot_count, const Config *cfg,
+                         const Node robot_starts[], const Survivor survivors[], int survivor_count);
+void fitness_batch_finish(void);
+int init_process_pool(int max_pop_size, int robot_count, int max_survivor_count, int pool_size,
+                      int pool_max, int pin_workers, int max_survivors_per_robot, int generation_buffers);
+// Starts the configured evaluation backend and fitness cache; later calls do nothing
+void fitness_backend_start(int pop_size, int robot_count, const Config *cfg,
+                           const Node robot_starts[], const Survivor survivors[], int survivor_count);
+// Generation buffer resident in the process pool's shared memory, where
+// workers evaluate it without copies. NULL when there is no pool or no free
+// buffer. free_population hands it back.
+Chromosome *shared_population_alloc(int pop_size, int robot_count, int max_survivors_per_robot);
+// Returns 1 and frees the buffer if pop came from shared_population_alloc
+int shared_population_release(Chromosome *pop, int pop_size);
 void shutdown_process_pool(void);
+FitnessCacheStats fitness_cache_last_stats(void);
 
+// Fills parent_idx[] with indices into pop[] (no chromosome copies)
 void tournament_select(const Chromosome pop[], int pop_size,
-                       Chromosome parents[], int parent_count, int robot_count);
+                       int parent_idx[], int parent_count, Rng *rng);
 
 void crossover(Chromosome *child, const Chromosome *p1, const Chromosome *p2,
-               int robot_count, int survivor_count, int max_survivors_per_robot);
+               int robot_count, int survivor_count, int max_survivors_per_robot, Rng *rng);
 
 void mutate(Chromosome *c, int robot_count, double rate, 
             const Node robot_starts[], const Survivor survivors[], 
-            int survivor_count, const Config *cfg);
+            int survivor_count, const Config *cfg, Rng *rng);
+
+// Crossover and mutation in the chromosomes' encoding (giant tour when all
+// three carry one), then local search if improve is set
+void breed_child(Chromosome *child, const Chromosome *p1, const Chromosome *p2,
+                 int robot_count, int survivor_count, double mutation_rate,
+                 const Node robot_starts[], const Survivor survivors[],
+                 const Config *cfg, int improve, Rng *rng);
 
 void sort_by_fitness(Chromosome pop[], int pop_size);
 
+// Free per-thread operator scratch; call before a thread that ran GA operators exits
+void ga_release_thread_scratch(void);
+
 void evolve_loop(int generations, Chromosome pop[], int pop_size,
                  int robot_count, double mutation_rate, int elitism_pct,
                  const Node robot_starts[], const Survivor survivors[],
-                 int survivor_count, const Config *cfg);
+                 int survivor_count, const Config *cfg, Rng *rng);
 
 #endif
\ No newline at end of file
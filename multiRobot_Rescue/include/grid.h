@@ -1,7 +1,9 @@
 #ifndef GRID_H
 #define GRID_H
 
+#include "astar.h"
 #include "config.h"
+#include "rng.h"
 
 typedef struct {
     int obstacle;      // 1 = debris, 0 = free
@@ -14,16 +16,38 @@ typedef struct {
 // Global pointer to 3D grid (allocated at runtime)
 extern Cell ***building;
 
+// Obstacle bit and risk level of every cell packed into one byte, flat in
+// [z][y][x] order, so traversal kernels read one small contiguous array
+#define VOXEL_OBSTACLE   0x1
+#define VOXEL_RISK_SHIFT 1
+extern unsigned char *voxels;
+
+// Obstacle and risk totals over a box of cells
+typedef struct {
+    int cells;
+    int obstacles;
+    int risk;
+} RegionStats;
+
 // Grid allocation and cleanup
 int allocate_grid(const Config *cfg);
 void free_grid(const Config *cfg);
 
 // Grid generation
-void generate_obstacles(const Config *cfg);
+void generate_obstacles(const Config *cfg, Rng *rng);
 void assign_risk_from_obstacles(const Config *cfg);
-void simulate_sensors(const Config *cfg);
+void simulate_sensors(const Config *cfg, Rng *rng);
 void detect_survivors(const Config *cfg);
 
+// (Re)builds voxels and the summed-area tables from building. Call once
+// the grid is final and again after any change to obstacles or risk.
+int grid_rebuild_indexes(const Config *cfg);
+
+// Totals over the box with corners a and b (inclusive, any order, clamped
+// to the grid) in O(1) from 3D summed-area tables. All zero until
+// grid_rebuild_indexes succeeded.
+RegionStats grid_box_stats(Node a, Node b, const Config *cfg);
+
 // Visualization
 int count_survivors(const Config *cfg);
 
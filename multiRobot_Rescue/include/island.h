@@ -0,0 +1,27 @@
+#ifndef ISLAND_H
+#define ISLAND_H
+
+#include "ga.h"
+#include "config.h"
+#include "rng.h"
+
+/**
+ * Island-model evolution.
+ *
+ * The population is split across cfg->island_count forked processes. Each
+ * island evolves its own subpopulation with the regular operators and
+ * evaluates it in-process. Every cfg->migration_interval generations an
+ * island publishes its best cfg->migration_size individuals to its mailbox
+ * in shared memory and imports the latest migrants of its source island
+ * (ring or random topology) in place of its worst individuals. Mailboxes are
+ * seqlocked, so islands never wait on each other.
+ *
+ * On return pop[] holds the best pop_size individuals over all islands,
+ * sorted by fitness.
+ */
+void evolve_islands(int generations, Chromosome pop[], int pop_size,
+                    int robot_count, double mutation_rate, int elitism_pct,
+                    const Node robot_starts[], const Survivor survivors[],
+                    int survivor_count, const Config *cfg, Rng *rng);
+
+#endif
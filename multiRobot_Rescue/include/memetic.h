@@ -0,0 +1,29 @@
+#ifndef MEMETIC_H
+#define MEMETIC_H
+
+#include "ga.h"
+#include "config.h"
+
+/**
+ * Memetic local search.
+ *
+ * Moves are scored in O(1) from the visit value table (cost_table.h):
+ *   - relocate: move one survivor to another robot with spare capacity
+ *   - exchange: swap two survivors between robots
+ *   - swap-in:  replace an assigned survivor with an unassigned one
+ * Each step applies the best improving move until none is left or
+ * cfg->local_search_moves moves were made. Moves never empty a robot or
+ * exceed max_survivors_per_robot.
+ *
+ * Visits are round trips from the robot's base, so reordering a mission
+ * (2-opt, Or-opt within a route) never changes fitness and is not tried.
+ */
+
+// Improves c in place (needs cost_table_init()). Returns the number of
+// moves applied; changed missions are marked dirty and the fitness is
+// invalidated.
+int local_search(Chromosome *c, int robot_count, const Config *cfg);
+
+void local_search_release_thread_scratch(void);
+
+#endif
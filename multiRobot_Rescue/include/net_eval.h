@@ -0,0 +1,49 @@
+#ifndef NET_EVAL_H
+#define NET_EVAL_H
+
+#include "ga.h"
+#include "config.h"
+
+/**
+ * Fitness evaluation on evaluator daemons over TCP (EVAL_BACKEND = tcp).
+ *
+ * `main --evaluator PORT [ADDRESS]` runs a daemon on ADDRESS (127.0.0.1 by
+ * default). Each connection it accepts gets a forked process that receives
+ * the scenario once (config plus one byte per grid cell with its obstacle,
+ * risk and survivor bits), rebuilds the grid indexes, then answers batches
+ * of chromosomes with fitness values until the master hangs up. There is no
+ * authentication, so bind to other addresses only on trusted networks; a
+ * peer must send its scenario within NET_CONNECT_SECONDS and no message may
+ * exceed what a full batch of that scenario needs.
+ *
+ * Chromosomes travel as genes plus the cached scores of clean missions. The
+ * daemon rescores the dirty missions and returns their scores with the
+ * fitness, as the shared-memory workers do. The master keeps at most
+ * NET_WINDOW batches in flight per evaluator and sends another only when a
+ * result comes back, so slow evaluators get less work and no queue grows
+ * without bound. Batches of an evaluator that fails or stops answering go
+ * to the others; whatever none can take is left to the local workers.
+ *
+ * Messages are in host byte order and carry sizeof(Config), so the master
+ * and its evaluators must run the same build on the same architecture.
+ */
+
+// Batches in flight per evaluator
+#define NET_WINDOW 4
+
+// Serves evaluation requests on bind_addr:port (IPv4); returns only if it
+// cannot listen
+int evaluator_serve(const char *bind_addr, int port);
+
+// Forks cfg->evaluator_spawn_local daemons on 127.0.0.1, connects to them
+// and to every host:port in cfg->evaluator_hosts and sends each the
+// scenario. Returns the number of evaluators ready.
+int net_eval_start(const Config *cfg, int robot_count);
+void net_eval_stop(void);
+int net_eval_active(void);
+
+// Scores pop[indices[0..count-1]] on the evaluators. Indices none of them
+// could score are written to leftover[]; returns how many.
+int net_eval_run(Chromosome pop[], const int indices[], int count, int robot_count, int leftover[]);
+
+#endif
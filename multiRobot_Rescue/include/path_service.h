@@ -0,0 +1,24 @@
+#ifndef PATH_SERVICE_H
+#define PATH_SERVICE_H
+
+#include "astar.h"
+#include "config.h"
+
+/**
+ * Exact path lengths from robot bases.
+ *
+ * Each base gets one breadth-first distance field over the 6-connected
+ * grid, which gives the same step counts as astar() for every goal at once.
+ * Fields are computed on first use and kept for the run. Warming them
+ * before the island engine forks lets every island share the parent's copy.
+ */
+
+// Computes the fields for bases[0..base_count) up front
+int path_service_init(const Node bases[], int base_count, const Config *cfg);
+void path_service_free(void);
+
+// Steps on the shortest path from base to goal, -1 if unreachable or out
+// of memory. Thread-safe; a base seen for the first time is searched once.
+int path_service_length(Node base, Node goal, const Config *cfg);
+
+#endif
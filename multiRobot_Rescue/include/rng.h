@@ -0,0 +1,64 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+/**
+ * xoshiro256** pseudo-random generator with explicit state.
+ *
+ * Every thread or worker owns its own Rng, so operators never share hidden
+ * global state. Independent streams are derived from one run seed with
+ * rng_jump(), which advances a generator by 2^128 draws.
+ */
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+// Expand a 64-bit seed into a full state (splitmix64)
+void rng_seed(Rng *rng, uint64_t seed);
+
+// Advance the generator by 2^128 draws
+void rng_jump(Rng *rng);
+
+// Copy of base advanced by `stream` jumps (stream 0 = base itself)
+void rng_stream(Rng *out, const Rng *base, int stream);
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t rng_next(Rng *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+
+    return result;
+}
+
+// Uniform integer in [0, bound), bound > 0 (Lemire's multiply-shift, unbiased)
+static inline uint32_t rng_below(Rng *rng, uint32_t bound) {
+    uint64_t m = (rng_next(rng) >> 32) * bound;
+    uint32_t low = (uint32_t)m;
+    if (low < bound) {
+        uint32_t threshold = -bound % bound;
+        while (low < threshold) {
+            m = (rng_next(rng) >> 32) * bound;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+// Uniform double in [0, 1)
+static inline double rng_uniform(Rng *rng) {
+    return (rng_next(rng) >> 11) * 0x1.0p-53;
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef SEEDING_H
+#define SEEDING_H
+
+#include "ga.h"
+#include "config.h"
+#include "rng.h"
+
+// Strategies mixed by seed_population (SEED_*_PERCENT)
+typedef enum {
+    SEED_RANDOM = 0,    // shuffled survivors split evenly across robots
+    SEED_NEAREST,       // each survivor to the robot with the best visit value
+    SEED_SWEEP,         // angular sectors around the robot starts
+    SEED_REGRET         // regret insertion: most contested survivor first
+} SeedStrategy;
+
+// Read-only data shared by all seeding threads
+typedef struct {
+    int robot_count;
+    int survivor_count;
+    int max_per_robot;
+    const Node *robot_starts;
+    const Survivor *survivors;
+    double *value;      // [r * survivor_count + sid], fitness value of the visit
+    double noise;       // perturbation amplitude that diversifies repeated heuristics
+    int axis_u;         // grid axes (0 = x, 1 = y, 2 = z) spanning the sweep plane
+    int axis_v;
+} SeedContext;
+
+int seed_context_init(SeedContext *ctx, const Node robot_starts[], int robot_count,
+                      const Survivor survivors[], int survivor_count, const Config *cfg);
+void seed_context_free(SeedContext *ctx);
+
+// Builds one individual with a constructive heuristic. perturb = 0 gives
+// the plain heuristic; otherwise visit values are jittered using rng.
+void seed_heuristic(Chromosome *c, SeedStrategy strategy, const SeedContext *ctx,
+                    int perturb, Rng *rng);
+
+#endif
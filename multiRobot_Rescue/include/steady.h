@@ -0,0 +1,24 @@
+#ifndef STEADY_H
+#define STEADY_H
+
+#include "ga.h"
+#include "config.h"
+#include "rng.h"
+
+/**
+ * Asynchronous steady-state evolution.
+ *
+ * cfg->pool_size evaluation threads pull freshly bred children from a queue
+ * while the calling thread keeps selecting and breeding from the current
+ * population. Each finished child replaces the worst individual if it is
+ * fitter, so there is no generation barrier. The run stops after the same
+ * number of child evaluations the generational loop would perform.
+ *
+ * On return pop[] is sorted by fitness.
+ */
+void evolve_steady_state(int generations, Chromosome pop[], int pop_size,
+                         int robot_count, double mutation_rate, int elitism_pct,
+                         const Node robot_starts[], const Survivor survivors[],
+                         int survivor_count, const Config *cfg, Rng *rng);
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+/**
+ * Fixed pthread pool with work-stealing parallel loops.
+ *
+ * thread_pool_run() cuts [0, count) into chunks and hands every thread,
+ * the caller included, a contiguous run of them in its own deque. A thread
+ * takes chunks from the back of its deque and, once it is empty, steals
+ * from the front of the others', so uneven chunks still finish together.
+ * Tasks run in the caller's address space; there is no copying and one
+ * wake-up per call.
+ */
+typedef struct ThreadPool ThreadPool;
+
+// Runs on the range [begin, end) of a parallel loop
+typedef void (*ThreadPoolTask)(void *arg, int begin, int end);
+
+// threads counts the caller, so threads - 1 workers are started. NULL on failure.
+ThreadPool *thread_pool_create(int threads);
+void thread_pool_destroy(ThreadPool *pool);
+int thread_pool_size(const ThreadPool *pool);
+
+// Calls task over [0, count) in chunks of at most grain (0 = automatic)
+// and returns when every chunk has run. Not reentrant.
+void thread_pool_run(ThreadPool *pool, int count, int grain, ThreadPoolTask task, void *arg);
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef TOUR_H
+#define TOUR_H
+
+#include "ga.h"
+#include "config.h"
+#include "rng.h"
+
+/**
+ * Giant-tour encoding (ENCODING = giant_tour).
+ *
+ * The genotype is one permutation of all survivors. tour_split() decodes it
+ * into missions by cutting the tour into contiguous segments, robot 0 first,
+ * so that the summed visit values (cost_table.h) are maximal under the
+ * per-robot capacity. Every robot gets at least one survivor when there are
+ * enough of them. Crossover and mutation work on the permutation, which
+ * stays valid by construction, so no repair is needed.
+ *
+ * Missions stay materialized as the phenotype: the fitness kernel, the
+ * worker pool and migration all read them.
+ */
+
+// Gives each chromosome a tour of survivor_count entries
+int tour_attach(Chromosome pop[], int pop_size, int survivor_count);
+// Frees the tours again, falling back to the mission encoding
+void tour_detach(Chromosome pop[], int pop_size);
+
+// Rebuilds the tour from the missions (assigned survivors in robot order,
+// then the unassigned ones), e.g. after seeding or local search
+void tour_from_missions(Chromosome *c, int robot_count);
+
+// Optimal split of the tour into missions, O(robots x survivors). Changed
+// missions are marked dirty. Returns -1 if the cost table is missing.
+int tour_split(Chromosome *c, int robot_count, const Config *cfg);
+
+// Order crossover (OX): a slice of p1 in place, the rest in p2's order
+void tour_crossover(Chromosome *child, const Chromosome *p1, const Chromosome *p2, Rng *rng);
+
+// robot_count trials, each with probability rate: swap, reverse or move
+void tour_mutate(Chromosome *c, int robot_count, double rate, Rng *rng);
+
+void tour_release_thread_scratch(void);
+
+#endif
@@ -0,0 +1,136 @@
+#include "all_headers.h"
+
+double monotonic_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int best_plan_init(BestPlanSlot *slot, int robot_count, int max_survivors_per_robot) {
+    memset(slot, 0, sizeof(*slot));
+    slot->robot_count = robot_count;
+    slot->max_survivors_per_robot = max_survivors_per_robot;
+    slot->plan = allocate_population(1, robot_count, max_survivors_per_robot);
+    return slot->plan ? 0 : -1;
+}
+
+void best_plan_free(BestPlanSlot *slot) {
+    if (slot->plan) free_population(slot->plan, 1, slot->robot_count);
+    slot->plan = NULL;
+}
+
+void best_plan_publish(BestPlanSlot *slot, const Chromosome *c, int generation) {
+    if (!slot->plan) return;
+    // A plan scored at a higher fidelity is never displaced by a lower one
+    if (slot->valid) {
+        if (c->fidelity < slot->plan->fidelity) return;
+        if (c->fidelity == slot->plan->fidelity && c->fitness <= slot->plan->fitness) return;
+    }
+    
+    unsigned int seq = slot->seq;
+    __atomic_store_n(&slot->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    copy_chromosome(slot->plan, c, slot->robot_count, slot->max_survivors_per_robot);
+    slot->generation = generation;
+    slot->published_at = monotonic_seconds();
+    slot->valid = 1;
+    __atomic_store_n(&slot->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+int best_plan_read(BestPlanSlot *slot, Chromosome *out, int *generation, double *published_at) {
+    if (!slot->plan) return 0;
+    
+    for (;;) {
+        unsigned int seq1 = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        if (seq1 & 1) {
+            sched_yield();
+            continue;
+        }
+        int valid = slot->valid;
+        int gen = slot->generation;
+        double at = slot->published_at;
+        if (valid) {
+            copy_chromosome(out, slot->plan, slot->robot_count, slot->max_survivors_per_robot);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq1) {
+            if (valid && generation) *generation = gen;
+            if (valid && published_at) *published_at = at;
+            return valid;
+        }
+    }
+}
+
+static BestPlanSlot *published_slot = NULL;
+
+void ga_set_best_plan_slot(BestPlanSlot *slot) {
+    published_slot = slot;
+}
+
+void ga_publish_best(const Chromosome *c, int generation) {
+    if (published_slot) best_plan_publish(published_slot, c, generation);
+}
+
+void stop_criteria_init(StopCriteria *sc, const Config *cfg) {
+    memset(sc, 0, sizeof(*sc));
+    if (cfg->time_budget_ms > 0) {
+        sc->deadline = monotonic_seconds() + cfg->time_budget_ms / 1000.0;
+    }
+    sc->stagnation_limit = cfg->stagnation_generations;
+    sc->min_diversity = cfg->min_diversity;
+    sc->best_fitness = -INFINITY;
+}
+
+void stop_criteria_free(StopCriteria *sc) {
+    free(sc->hashes);
+    sc->hashes = NULL;
+    sc->hash_capacity = 0;
+}
+
+static int compare_hash(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Fraction of individuals with a distinct gene layout
+static double population_diversity(StopCriteria *sc, const Chromosome pop[], int pop_size, int robot_count) {
+    if (pop_size > sc->hash_capacity) {
+        uint64_t *grown = realloc(sc->hashes, pop_size * sizeof(uint64_t));
+        if (!grown) return 1.0;
+        sc->hashes = grown;
+        sc->hash_capacity = pop_size;
+    }
+    for (int i = 0; i < pop_size; i++) {
+        sc->hashes[i] = chromosome_hash(&pop[i], robot_count);
+    }
+    qsort(sc->hashes, pop_size, sizeof(uint64_t), compare_hash);
+    
+    int distinct = pop_size > 0 ? 1 : 0;
+    for (int i = 1; i < pop_size; i++) {
+        if (sc->hashes[i] != sc->hashes[i - 1]) distinct++;
+    }
+    return pop_size > 0 ? (double)distinct / pop_size : 1.0;
+}
+
+const char *stop_criteria_check(StopCriteria *sc, const Chromosome pop[], int pop_size,
+                                int robot_count, int generation) {
+    if (pop_size <= 0) return NULL;
+    
+    if (pop[0].fitness > sc->best_fitness + 1e-9) {
+        sc->best_fitness = pop[0].fitness;
+        sc->last_improvement = generation;
+    }
+    
+    if (sc->deadline > 0.0 && monotonic_seconds() >= sc->deadline) {
+        return "time budget exhausted";
+    }
+    if (sc->stagnation_limit > 0 && generation - sc->last_improvement >= sc->stagnation_limit) {
+        return "no improvement";
+    }
+    if (sc->min_diversity > 0.0 &&
+        population_diversity(sc, pop, pop_size, robot_count) < sc->min_diversity) {
+        return "diversity collapsed";
+    }
+    return NULL;
+}
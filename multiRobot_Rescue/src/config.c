@@ -4,8 +4,20 @@ int load_config(const char *filename, Config *cfg) {
     // Set default values
     cfg->mutation_rate = 0.1;
     cfg->elitism_percent = 10;
-    cfg->pool_size = 4;
+    cfg->pool_size = 0;
+    cfg->pool_max = 0;
+    cfg->pin_workers = 0;
     cfg->max_survivors_per_robot = 20;
+    cfg->fitness_cache_size = 4096;
+    cfg->ga_engine = GA_ENGINE_GENERATIONAL;
+    cfg->encoding = ENCODING_MISSIONS;
+    cfg->eval_backend = EVAL_BACKEND_PROCESS;
+    cfg->migration_interval = 10;
+    cfg->migration_size = 2;
+    cfg->migration_topology = MIGRATION_RING;
+    cfg->local_search = LOCAL_SEARCH_OFF;
+    cfg->local_search_moves = 20;
+    cfg->exact_top_k = 5;
     
     FILE *file = fopen(filename, "r");
     if (!file) {
@@ -15,7 +27,7 @@ int load_config(const char *filename, Config *cfg) {
 
     char line[256];
     char key[64];
-    char value[64];
+    char value[192];
 
     while (fgets(line, sizeof(line), file)) {
         size_t len = strlen(line);
@@ -29,7 +41,7 @@ int load_config(const char *filename, Config *cfg) {
         }
 
         // Parse 
-        if (sscanf(line, " %63[^=] = %63s", key, value) == 2) {
+        if (sscanf(line, " %63[^=] = %191s", key, value) == 2) {
             len = strlen(key);
             while (len > 0 && key[len-1] == ' ') {
                 key[len-1] = '\0';
@@ -48,19 +60,97 @@ int load_config(const char *filename, Config *cfg) {
             else if (strcmp(key, "MUTATION_RATE") == 0) cfg->mutation_rate = atof(value);
             else if (strcmp(key, "ELITISM_PERCENT") == 0) cfg->elitism_percent = atoi(value);
             else if (strcmp(key, "POOL_SIZE") == 0) cfg->pool_size = atoi(value);
+            else if (strcmp(key, "POOL_MAX") == 0) cfg->pool_max = atoi(value);
+            else if (strcmp(key, "PIN_WORKERS") == 0) cfg->pin_workers = atoi(value);
+            else if (strcmp(key, "BREED_THREADS") == 0) cfg->breed_threads = atoi(value);
+            else if (strcmp(key, "GA_ENGINE") == 0) {
+                if (strcmp(value, "generational") == 0) cfg->ga_engine = GA_ENGINE_GENERATIONAL;
+                else if (strcmp(value, "island") == 0) cfg->ga_engine = GA_ENGINE_ISLAND;
+                else if (strcmp(value, "steady") == 0) cfg->ga_engine = GA_ENGINE_STEADY;
+                else if (strcmp(value, "pipelined") == 0) cfg->ga_engine = GA_ENGINE_PIPELINED;
+                else fprintf(stderr, "Warning: unknown GA_ENGINE '%s', using generational\n", value);
+            }
+            else if (strcmp(key, "EVAL_BACKEND") == 0) {
+                if (strcmp(value, "process") == 0) cfg->eval_backend = EVAL_BACKEND_PROCESS;
+                else if (strcmp(value, "thread") == 0) cfg->eval_backend = EVAL_BACKEND_THREAD;
+                else if (strcmp(value, "tcp") == 0) cfg->eval_backend = EVAL_BACKEND_TCP;
+                else fprintf(stderr, "Warning: unknown EVAL_BACKEND '%s', using process\n", value);
+            }
+            else if (strcmp(key, "EVALUATOR_HOSTS") == 0) {
+                if (strcmp(value, "none") != 0) {
+                    snprintf(cfg->evaluator_hosts, sizeof(cfg->evaluator_hosts), "%s", value);
+                }
+            }
+            else if (strcmp(key, "EVALUATOR_SPAWN_LOCAL") == 0) cfg->evaluator_spawn_local = atoi(value);
+            else if (strcmp(key, "ENCODING") == 0) {
+                if (strcmp(value, "missions") == 0) cfg->encoding = ENCODING_MISSIONS;
+                else if (strcmp(value, "giant_tour") == 0) cfg->encoding = ENCODING_GIANT_TOUR;
+                else fprintf(stderr, "Warning: unknown ENCODING '%s', using missions\n", value);
+            }
+            else if (strcmp(key, "ISLAND_COUNT") == 0) cfg->island_count = atoi(value);
+            else if (strcmp(key, "MIGRATION_INTERVAL") == 0) cfg->migration_interval = atoi(value);
+            else if (strcmp(key, "MIGRATION_SIZE") == 0) cfg->migration_size = atoi(value);
+            else if (strcmp(key, "MIGRATION_TOPOLOGY") == 0) {
+                if (strcmp(value, "ring") == 0) cfg->migration_topology = MIGRATION_RING;
+                else if (strcmp(value, "random") == 0) cfg->migration_topology = MIGRATION_RANDOM;
+                else fprintf(stderr, "Warning: unknown MIGRATION_TOPOLOGY '%s', using ring\n", value);
+            }
             else if (strcmp(key, "MAX_SURVIVORS_PER_ROBOT") == 0) cfg->max_survivors_per_robot = atoi(value);
+            else if (strcmp(key, "FITNESS_CACHE_SIZE") == 0) cfg->fitness_cache_size = atoi(value);
+            else if (strcmp(key, "SEED_NEAREST_PERCENT") == 0) cfg->seed_nearest_percent = atoi(value);
+            else if (strcmp(key, "SEED_SWEEP_PERCENT") == 0) cfg->seed_sweep_percent = atoi(value);
+            else if (strcmp(key, "SEED_REGRET_PERCENT") == 0) cfg->seed_regret_percent = atoi(value);
+            else if (strcmp(key, "LOCAL_SEARCH") == 0) {
+                if (strcmp(value, "off") == 0) cfg->local_search = LOCAL_SEARCH_OFF;
+                else if (strcmp(value, "elites") == 0) cfg->local_search = LOCAL_SEARCH_ELITES;
+                else if (strcmp(value, "children") == 0) cfg->local_search = LOCAL_SEARCH_CHILDREN;
+                else if (strcmp(value, "all") == 0) cfg->local_search = LOCAL_SEARCH_ALL;
+                else fprintf(stderr, "Warning: unknown LOCAL_SEARCH '%s', using off\n", value);
+            }
+            else if (strcmp(key, "LOCAL_SEARCH_MOVES") == 0) cfg->local_search_moves = atoi(value);
+            else if (strcmp(key, "EXACT_TOP_K") == 0) cfg->exact_top_k = atoi(value);
+            else if (strcmp(key, "TIME_BUDGET_MS") == 0) cfg->time_budget_ms = atoi(value);
+            else if (strcmp(key, "STAGNATION_GENERATIONS") == 0) cfg->stagnation_generations = atoi(value);
+            else if (strcmp(key, "MIN_DIVERSITY") == 0) cfg->min_diversity = atof(value);
+            else if (strcmp(key, "RANDOM_SEED") == 0) cfg->random_seed = strtoull(value, NULL, 10);
         }
     }
 
-    if (cfg->pool_size <= 0) {
-        cfg->pool_size = 1;  // Ensure at least one worker
-    }
+    if (cfg->pool_size < 0) cfg->pool_size = 0;  // automatic
+    if (cfg->pool_max < 0) cfg->pool_max = 0;
     
     // Validate max_survivors_per_robot
     if (cfg->max_survivors_per_robot <= 0) {
         cfg->max_survivors_per_robot = 20;  // Default if not set or invalid
     }
     
+    if (cfg->migration_interval <= 0) {
+        cfg->migration_interval = 10;
+    }
+    if (cfg->migration_size < 0) {
+        cfg->migration_size = 0;
+    }
+    
+    if (cfg->fitness_cache_size < 0) {
+        cfg->fitness_cache_size = 0;
+    }
+    
+    // Heuristic shares are percentages that together cover at most everyone
+    int *seed_percents[3] = {&cfg->seed_nearest_percent, &cfg->seed_sweep_percent, &cfg->seed_regret_percent};
+    int seed_total = 0;
+    for (int k = 0; k < 3; k++) {
+        if (*seed_percents[k] < 0) *seed_percents[k] = 0;
+        if (seed_total + *seed_percents[k] > 100) *seed_percents[k] = 100 - seed_total;
+        seed_total += *seed_percents[k];
+    }
+    
+    if (cfg->local_search_moves < 0) cfg->local_search_moves = 0;
+    if (cfg->exact_top_k < 0) cfg->exact_top_k = 0;
+    if (cfg->time_budget_ms < 0) cfg->time_budget_ms = 0;
+    if (cfg->stagnation_generations < 0) cfg->stagnation_generations = 0;
+    if (cfg->min_diversity < 0.0) cfg->min_diversity = 0.0;
+    if (cfg->min_diversity > 1.0) cfg->min_diversity = 1.0;
+    
 
     fclose(file);
     return 0;
@@ -0,0 +1,75 @@
+#include "all_headers.h"
+
+static CostTable cost_table = {0};
+
+static const double *ranking_row = NULL;
+
+static int compare_value_desc(const void *a, const void *b) {
+    double x = ranking_row[*(const int *)a];
+    double y = ranking_row[*(const int *)b];
+    return (x < y) - (x > y);
+}
+
+void cost_table_free(void) {
+    free(cost_table.bases);
+    free(cost_table.value);
+    free(cost_table.ranked);
+    cost_table = (CostTable){0};
+}
+
+const CostTable *cost_table_get(void) {
+    return cost_table.value ? &cost_table : NULL;
+}
+
+int cost_table_matches(const CostTable *ct, const Chromosome *c, int robot_count) {
+    if (!ct || robot_count != ct->robot_count) return 0;
+    for (int r = 0; r < robot_count; r++) {
+        Node a = ct->bases[r];
+        Node b = c->missions[r].robot_pos;
+        if (a.x != b.x || a.y != b.y || a.z != b.z) return 0;
+    }
+    return 1;
+}
+
+int cost_table_init(const Chromosome *reference, int robot_count, int survivor_count,
+                    const Config *cfg) {
+    if (!reference || robot_count <= 0 || !cfg) return -1;
+    
+    int known = fitness_survivor_total();
+    if (survivor_count > known) survivor_count = known;
+    if (survivor_count <= 0) return -1;
+    
+    // Already built for these bases
+    if (cost_table.value && cost_table.survivor_count == survivor_count &&
+        cost_table_matches(&cost_table, reference, robot_count)) {
+        return 0;
+    }
+    
+    cost_table_free();
+    size_t cells = (size_t)robot_count * survivor_count;
+    cost_table.bases = malloc(robot_count * sizeof(Node));
+    cost_table.value = malloc(cells * sizeof(double));
+    cost_table.ranked = malloc(cells * sizeof(int));
+    if (!cost_table.bases || !cost_table.value || !cost_table.ranked) {
+        fprintf(stderr, "Failed to allocate visit cost table\n");
+        cost_table_free();
+        return -1;
+    }
+    cost_table.robot_count = robot_count;
+    cost_table.survivor_count = survivor_count;
+    
+    for (int r = 0; r < robot_count; r++) {
+        Node base = reference->missions[r].robot_pos;
+        double *row = &cost_table.value[(size_t)r * survivor_count];
+        int *ranked = &cost_table.ranked[(size_t)r * survivor_count];
+        cost_table.bases[r] = base;
+        for (int sid = 0; sid < survivor_count; sid++) {
+            row[sid] = fitness_visit_value(base, sid, cfg);
+            ranked[sid] = sid;
+        }
+        ranking_row = row;
+        qsort(ranked, survivor_count, sizeof(int), compare_value_desc);
+    }
+    ranking_row = NULL;
+    return 0;
+}
@@ -0,0 +1,78 @@
+#define _GNU_SOURCE
+#include "all_headers.h"
+#include <sched.h>
+
+int cpuset_available(void) {
+    cpu_set_t mask;
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        int count = CPU_COUNT(&mask);
+        if (count > 0) return count;
+    }
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+}
+
+// Node of cpu from its sysfs nodeN link, -1 without NUMA topology
+static int cpu_node(int cpu) {
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+    DIR *dir = opendir(path);
+    if (!dir) return -1;
+    
+    int node = -1;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strncmp(entry->d_name, "node", 4) == 0 &&
+            entry->d_name[4] >= '0' && entry->d_name[4] <= '9') {
+            node = atoi(entry->d_name + 4);
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+}
+
+int cpuset_list(int cpus[], int max) {
+    cpu_set_t mask;
+    int count = 0;
+    if (sched_getaffinity(0, sizeof(mask), &mask) != 0) {
+        int online = cpuset_available();
+        for (int cpu = 0; cpu < online && count < max; cpu++) cpus[count++] = cpu;
+        return count;
+    }
+    
+    int all[CPU_SETSIZE];
+    int nodes[CPU_SETSIZE];
+    int total = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &mask)) continue;
+        all[total] = cpu;
+        nodes[total] = cpu_node(cpu);
+        total++;
+    }
+    
+    // Home node first, then the rest by node; stable within a node
+    int current = sched_getcpu();
+    int home = current >= 0 ? cpu_node(current) : -1;
+    for (int i = 0; i < total && count < max; i++) {
+        if (nodes[i] == home) cpus[count++] = all[i];
+    }
+    int max_node = -1;
+    for (int i = 0; i < total; i++) {
+        if (nodes[i] > max_node) max_node = nodes[i];
+    }
+    for (int node = -1; node <= max_node && count < max; node++) {
+        if (node == home) continue;
+        for (int i = 0; i < total && count < max; i++) {
+            if (nodes[i] == node) cpus[count++] = all[i];
+        }
+    }
+    return count;
+}
+
+int cpuset_pin(int cpu) {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+    return sched_setaffinity(0, sizeof(mask), &mask);
+}
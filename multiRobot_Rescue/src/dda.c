@@ -0,0 +1,200 @@
+#include "all_headers.h"
+
+static int clamp_axis(int v, int size) {
+    if (v < 0) return 0;
+    if (v >= size) return size - 1;
+    return v;
+}
+
+static Node clamp_node(Node n, const Config *cfg) {
+    n.x = clamp_axis(n.x, cfg->grid_x);
+    n.y = clamp_axis(n.y, cfg->grid_y);
+    n.z = clamp_axis(n.z, cfg->grid_z);
+    return n;
+}
+
+static unsigned char voxel_at(int x, int y, int z, const Config *cfg) {
+    if (voxels) return voxels[((size_t)z * cfg->grid_y + y) * cfg->grid_x + x];
+    if (!building) return 0;
+    const Cell *cell = &building[z][y][x];
+    return (cell->obstacle ? VOXEL_OBSTACLE : 0) |
+           (unsigned char)((cell->risk & 0x3) << VOXEL_RISK_SHIFT);
+}
+
+// Per-axis stepping state. The k-th boundary crossing on an axis spanning n
+// voxels happens at t = (2k + 1) / (2n); scaling by 2 * span, the product of
+// all nonzero spans, keeps every crossing time an exact integer.
+typedef struct {
+    int steps;              // total voxel steps, |dx| + |dy| + |dz|
+    int dir[3];             // -1, 0 or +1 per axis
+    long long next[3];      // scaled time of the next crossing per axis
+    long long inc[3];       // scaled time between crossings per axis
+} DdaSetup;
+
+static void dda_setup(Node a, Node b, DdaSetup *s) {
+    int d[3] = {b.x - a.x, b.y - a.y, b.z - a.z};
+    long long span = 1;
+    s->steps = 0;
+    for (int k = 0; k < 3; k++) {
+        int n = abs(d[k]);
+        if (n > 0) span *= n;
+        s->steps += n;
+    }
+    for (int k = 0; k < 3; k++) {
+        int n = abs(d[k]);
+        s->dir[k] = (d[k] > 0) - (d[k] < 0);
+        if (n > 0) {
+            s->next[k] = span / n;
+            s->inc[k] = 2 * (span / n);
+        } else {
+            s->next[k] = LLONG_MAX;
+            s->inc[k] = 0;
+        }
+    }
+}
+
+void dda_trace(Node a, Node b, const Config *cfg, SegmentTrace *out) {
+    a = clamp_node(a, cfg);
+    b = clamp_node(b, cfg);
+    
+    DdaSetup s;
+    dda_setup(a, b, &s);
+    
+    int pos[3] = {a.x, a.y, a.z};
+    unsigned char v = voxel_at(pos[0], pos[1], pos[2], cfg);
+    int obstacles = v & VOXEL_OBSTACLE;
+    int risk = v >> VOXEL_RISK_SHIFT;
+    
+    for (int i = 0; i < s.steps; i++) {
+        // Earliest crossing wins; ties go to x, then y
+        int axis = (s.next[0] <= s.next[1] && s.next[0] <= s.next[2]) ? 0 :
+                   (s.next[1] <= s.next[2] ? 1 : 2);
+        pos[axis] += s.dir[axis];
+        s.next[axis] += s.inc[axis];
+        
+        v = voxel_at(pos[0], pos[1], pos[2], cfg);
+        obstacles += v & VOXEL_OBSTACLE;
+        risk += v >> VOXEL_RISK_SHIFT;
+    }
+    
+    out->cells = s.steps + 1;
+    out->obstacles = obstacles;
+    out->risk = risk;
+}
+
+// Lane state of dda_trace_batch, one array per field
+typedef struct {
+    int seg[DDA_LANES];                  // segment traced by the lane, -1 = idle
+    int remaining[DDA_LANES];            // voxel steps left
+    int cells[DDA_LANES];                // voxels of the clamped segment
+    int px[DDA_LANES], py[DDA_LANES], pz[DDA_LANES];
+    int sx[DDA_LANES], sy[DDA_LANES], sz[DDA_LANES];
+    int nx[DDA_LANES], ny[DDA_LANES], nz[DDA_LANES];
+    int ix[DDA_LANES], iy[DDA_LANES], iz[DDA_LANES];
+    int obstacles[DDA_LANES], risk[DDA_LANES];
+} DdaLanes;
+
+// Scaled crossing times as int; the caller checked they fit
+static int lane_time(long long t) {
+    return (int)(t < INT_MAX ? t : INT_MAX);
+}
+
+// Puts segment i on lane l and counts its first voxel
+static void lane_load(DdaLanes *ln, int l, int i, const Node a[], const Node b[], const Config *cfg) {
+    Node from = clamp_node(a[i], cfg);
+    Node to = clamp_node(b[i], cfg);
+    DdaSetup s;
+    dda_setup(from, to, &s);
+    
+    ln->seg[l] = i;
+    ln->remaining[l] = s.steps;
+    ln->cells[l] = s.steps + 1;
+    ln->px[l] = from.x; ln->py[l] = from.y; ln->pz[l] = from.z;
+    ln->sx[l] = s.dir[0]; ln->sy[l] = s.dir[1]; ln->sz[l] = s.dir[2];
+    ln->nx[l] = lane_time(s.next[0]);
+    ln->ny[l] = lane_time(s.next[1]);
+    ln->nz[l] = lane_time(s.next[2]);
+    ln->ix[l] = (int)s.inc[0]; ln->iy[l] = (int)s.inc[1]; ln->iz[l] = (int)s.inc[2];
+    
+    unsigned char v = voxel_at(from.x, from.y, from.z, cfg);
+    ln->obstacles[l] = v & VOXEL_OBSTACLE;
+    ln->risk[l] = v >> VOXEL_RISK_SHIFT;
+}
+
+void dda_trace_batch(const Node a[], const Node b[], int count, const Config *cfg,
+                     SegmentTrace out[]) {
+    // Scaled crossing times reach 3 * |dx| * |dy| * |dz|; lanes keep them in int
+    long long span = (long long)cfg->grid_x * cfg->grid_y * cfg->grid_z;
+    if (!voxels || span > INT_MAX / 3) {
+        for (int i = 0; i < count; i++) dda_trace(a[i], b[i], cfg, &out[i]);
+        return;
+    }
+    
+    const int gx = cfg->grid_x;
+    const int gy = cfg->grid_y;
+    DdaLanes ln;
+    int next_seg = 0;
+    int live = 0;
+    
+    for (int l = 0; l < DDA_LANES; l++) {
+        ln.seg[l] = -1;
+        ln.remaining[l] = 0;
+    }
+    
+    // A lane that finishes its segment takes the next one, so lanes never
+    // idle while segments of different lengths are left
+    int refill = 1;
+    for (;;) {
+        if (refill) {
+            for (int l = 0; l < DDA_LANES; l++) {
+                while (ln.remaining[l] == 0) {
+                    int done = ln.seg[l];
+                    if (done >= 0) {
+                        SegmentTrace *t = &out[done];
+                        t->cells = ln.cells[l];
+                        t->obstacles = ln.obstacles[l];
+                        t->risk = ln.risk[l];
+                        ln.seg[l] = -1;
+                        live--;
+                    }
+                    if (next_seg >= count) break;
+                    lane_load(&ln, l, next_seg++, a, b, cfg);
+                    live++;
+                }
+            }
+            if (live == 0) break;
+        }
+        
+        // Stepping and voxel loads are separate loops so the stepping has
+        // no gathers in it and vectorizes. Idle lanes step with a zero mask
+        // and load voxel 0 without counting it.
+        int index[DDA_LANES];
+        int mask[DDA_LANES];
+        refill = 0;
+        for (int l = 0; l < DDA_LANES; l++) {
+            int active = ln.remaining[l] > 0;
+            int tx = (ln.nx[l] <= ln.ny[l]) & (ln.nx[l] <= ln.nz[l]);
+            int ty = !tx & (ln.ny[l] <= ln.nz[l]);
+            int tz = !tx & !ty;
+            tx &= active;
+            ty &= active;
+            tz &= active;
+            
+            ln.px[l] += tx * ln.sx[l];
+            ln.py[l] += ty * ln.sy[l];
+            ln.pz[l] += tz * ln.sz[l];
+            ln.nx[l] += tx * ln.ix[l];
+            ln.ny[l] += ty * ln.iy[l];
+            ln.nz[l] += tz * ln.iz[l];
+            ln.remaining[l] -= active;
+            index[l] = active * ((ln.pz[l] * gy + ln.py[l]) * gx + ln.px[l]);
+            mask[l] = -active;
+            refill |= ln.remaining[l] == 0;
+        }
+        for (int l = 0; l < DDA_LANES; l++) {
+            int v = voxels[index[l]] & mask[l];
+            ln.obstacles[l] += v & VOXEL_OBSTACLE;
+            ln.risk[l] += v >> VOXEL_RISK_SHIFT;
+        }
+    }
+}
@@ -6,21 +6,30 @@ Chromosome *allocate_population(int pop_size, int robot_count, int max_survivors
 
     for (int i = 0; i < pop_size; i++) {
         pop[i].missions = malloc(robot_count * sizeof(RobotMission));
-        if (!pop[i].missions) {
+        pop[i].scores = malloc(robot_count * sizeof(MissionScore));
+        if (!pop[i].missions || !pop[i].scores) {
             // Free previously allocated missions and pop
+            free(pop[i].missions);
+            free(pop[i].scores);
             for (int j = 0; j < i; j++) {
                 for (int r = 0; r < robot_count; r++) {
                     free(pop[j].missions[r].survivor_sequence);
                 }
                 free(pop[j].missions);
+                free(pop[j].scores);
             }
             free(pop);
             return NULL;
         }
 
         // initialize fitness and missions
+        pop[i].tour = NULL;
+        pop[i].tour_length = 0;
+        pop[i].fidelity = FIDELITY_ESTIMATE;
         pop[i].fitness = 0.0;
+        pop[i].fitness_valid = 0;
         for (int r = 0; r < robot_count; r++) {
+            pop[i].scores[r] = (MissionScore){0.0, 0.0, 0, 1};  // Not scored yet
             pop[i].missions[r].robot_pos = (Node){0, 0, 0};  // Default start
             pop[i].missions[r].survivor_count = 0;  // No survivors assigned yet
             pop[i].missions[r].survivor_sequence = malloc(max_survivors_per_robot * sizeof(int));
@@ -30,11 +39,13 @@ Chromosome *allocate_population(int pop_size, int robot_count, int max_survivors
                     free(pop[i].missions[rr].survivor_sequence);
                 }
                 free(pop[i].missions);
+                free(pop[i].scores);
                 for (int j = 0; j < i; j++) {
                     for (int rr = 0; rr < robot_count; rr++) {
                         free(pop[j].missions[rr].survivor_sequence);
                     }
                     free(pop[j].missions);
+                    free(pop[j].scores);
                 }
                 free(pop);
                 return NULL;
@@ -50,7 +61,7 @@ Chromosome *allocate_population(int pop_size, int robot_count, int max_survivors
 }
 
 void free_population(Chromosome *pop, int pop_size, int robot_count) {
-    if (!pop) return;
+    if (!pop || shared_population_release(pop, pop_size)) return;
 
     for (int i = 0; i < pop_size; i++) {
         if (pop[i].missions) {
@@ -60,13 +71,152 @@ void free_population(Chromosome *pop, int pop_size, int robot_count) {
             }
             free(pop[i].missions);
         }
+        free(pop[i].scores);
+        free(pop[i].tour);
     }
     free(pop);
 }
 
-void seed_population(Chromosome pop[], int pop_size, const Node robot_starts[], int robot_count, const Survivor survivors[], int survivor_count, const Config *cfg) { 
-    (void)survivors; 
-    (void)cfg;      
+// Deep copy of genes and cached mission scores
+void copy_chromosome(Chromosome *dst, const Chromosome *src, int robot_count, int max_survivors_per_robot) {
+    for (int r = 0; r < robot_count; r++) {
+        RobotMission *dst_mission = &dst->missions[r];
+        const RobotMission *src_mission = &src->missions[r];
+        
+        dst_mission->robot_pos = src_mission->robot_pos;
+        dst_mission->survivor_count = src_mission->survivor_count;
+        memcpy(dst_mission->survivor_sequence, src_mission->survivor_sequence,
+               max_survivors_per_robot * sizeof(int));
+        dst->scores[r] = src->scores[r];
+    }
+    if (dst->tour && src->tour && dst->tour_length == src->tour_length) {
+        memcpy(dst->tour, src->tour, src->tour_length * sizeof(int));
+    } else if (dst->tour) {
+        tour_from_missions(dst, robot_count);
+    }
+    dst->fitness = src->fitness;
+    dst->fitness_valid = src->fitness_valid;
+    dst->fidelity = src->fidelity;
+}
+
+static void mark_mission_dirty(Chromosome *c, int r) {
+    if (c->scores) c->scores[r].dirty = 1;
+}
+
+// Shuffled survivors split evenly across robots
+static void seed_random_individual(Chromosome *c, const Node robot_starts[], int robot_count,
+                                   int survivor_count, const Config *cfg, Rng *rng) {
+    // Create a list of all survivor IDs
+    int available_survivors[survivor_count];
+    for (int s = 0; s < survivor_count; s++) {
+        available_survivors[s] = s;
+    }
+    
+    // Shuffle the list for each chromosome
+    for (int s = survivor_count - 1; s > 0; s--) {
+        int j = rng_below(rng, s + 1);
+        int temp = available_survivors[s];
+        available_survivors[s] = available_survivors[j];
+        available_survivors[j] = temp;
+    }
+
+    //  ensure each robot gets at least one survivor
+    int survivors_per_robot_base = survivor_count / robot_count;
+    int extra_survivors = survivor_count % robot_count;
+    int survivor_idx = 0;
+    
+    for (int r = 0; r < robot_count; r++) {
+        RobotMission *mission = &c->missions[r];
+        mission->robot_pos = robot_starts ? robot_starts[r] : (Node){0, 0, 0};
+        
+        // Each robot gets base number of survivors and extra if available
+        int count = survivors_per_robot_base + (r < extra_survivors ? 1 : 0);
+        int max_per_robot = cfg->max_survivors_per_robot;
+        if (count > max_per_robot) count = max_per_robot;
+        
+        // Assign survivors in round-robin fashion
+        for (int s = 0; s < count && survivor_idx < survivor_count; s++) {
+            mission->survivor_sequence[s] = available_survivors[survivor_idx++];
+        }
+        
+        mission->survivor_count = count;
+        
+        // Fill remaining slots with -1
+        for (int s = count; s < max_per_robot; s++) {
+            mission->survivor_sequence[s] = -1;
+        }
+        mark_mission_dirty(c, r);
+    }
+    
+    // distribute extra servivors to robots with fewer assignments
+    int max_per_robot_limit = cfg->max_survivors_per_robot;
+    while (survivor_idx < survivor_count) {
+        // Find robot with fewest assignments
+        int min_robot = 0;
+        int min_count = c->missions[0].survivor_count;
+        for (int r = 1; r < robot_count; r++) {
+            if (c->missions[r].survivor_count < min_count) {
+                min_count = c->missions[r].survivor_count;
+                min_robot = r;
+            }
+        }
+        
+        if (min_count < max_per_robot_limit) {
+            c->missions[min_robot].survivor_sequence[min_count] = available_survivors[survivor_idx++];
+            c->missions[min_robot].survivor_count++;
+        } else {
+            break;
+        }
+    }
+
+    c->fitness = 0.0; 
+    c->fitness_valid = 0;
+}
+
+// One seeding thread's share of the population. Individuals
+// [0, bounds[0]) are nearest, [bounds[0], bounds[1]) sweep,
+// [bounds[1], bounds[2]) regret and the rest random.
+typedef struct {
+    Chromosome *pop;
+    int begin;
+    int end;
+    const int *bounds;
+    const SeedContext *ctx;     // NULL when only random seeding is needed
+    const Node *robot_starts;
+    int robot_count;
+    int survivor_count;
+    const Config *cfg;
+    Rng *rng;
+    Rng own_rng;
+    pthread_t thread;
+} SeedSlice;
+
+static void *seed_slice(void *arg) {
+    SeedSlice *slice = (SeedSlice *)arg;
+    
+    for (int i = slice->begin; i < slice->end; i++) {
+        SeedStrategy strategy = SEED_RANDOM;
+        int first = 0;
+        for (int k = 0; k < 3; k++) {
+            if (i < slice->bounds[k]) {
+                strategy = (SeedStrategy)(SEED_NEAREST + k);
+                first = (k == 0) ? 0 : slice->bounds[k - 1];
+                break;
+            }
+        }
+        
+        if (strategy == SEED_RANDOM || !slice->ctx) {
+            seed_random_individual(&slice->pop[i], slice->robot_starts, slice->robot_count,
+                                   slice->survivor_count, slice->cfg, slice->rng);
+        } else {
+            // The first individual of each heuristic is the unperturbed one
+            seed_heuristic(&slice->pop[i], strategy, slice->ctx, i != first, slice->rng);
+        }
+    }
+    return NULL;
+}
+
+void seed_population(Chromosome pop[], int pop_size, const Node robot_starts[], int robot_count, const Survivor survivors[], int survivor_count, const Config *cfg, Rng *rng) { 
     if (survivor_count == 0) {
         printf("Warning: No survivors detected. All robots will be unassigned.\n");
         // Initialize all missions 
@@ -78,8 +228,10 @@ void seed_population(Chromosome pop[], int pop_size, const Node robot_starts[],
                 for (int s = 0; s < max_per_robot; s++) {
                     pop[i].missions[r].survivor_sequence[s] = -1;
                 }
+                mark_mission_dirty(&pop[i], r);
             }
             pop[i].fitness = 0.0;
+            pop[i].fitness_valid = 0;
         }
         return;
     }
@@ -92,71 +244,97 @@ void seed_population(Chromosome pop[], int pop_size, const Node robot_starts[],
         return;
     }
 
-    for (int i = 0; i < pop_size; i++) {
-       
-        // Create a list of all survivor IDs
-        int available_survivors[survivor_count];
-        for (int s = 0; s < survivor_count; s++) {
-            available_survivors[s] = s;
+    // Heuristic share of the population, in strategy order
+    int percents[3] = {cfg->seed_nearest_percent, cfg->seed_sweep_percent, cfg->seed_regret_percent};
+    int bounds[3];
+    int seeded = 0;
+    for (int k = 0; k < 3; k++) {
+        seeded += (int)((long)pop_size * percents[k] / 100);
+        if (seeded > pop_size) seeded = pop_size;
+        bounds[k] = seeded;
+    }
+    
+    SeedContext ctx;
+    const SeedContext *heuristics = NULL;
+    if (bounds[2] > 0 && robot_starts && survivors) {
+        if (seed_context_init(&ctx, robot_starts, robot_count, survivors, survivor_count, cfg) == 0) {
+            heuristics = &ctx;
+        } else {
+            fprintf(stderr, "Warning: heuristic seeding unavailable, seeding randomly\n");
         }
+    }
+    
+    // Seeding threads: same count as the breeding threads
+    int threads = cfg->breed_threads > 0 ? cfg->breed_threads : cpuset_available();
+    if (threads > pop_size) threads = pop_size;
+    
+    SeedSlice single;
+    SeedSlice *slices = threads > 1 ? calloc(threads, sizeof(SeedSlice)) : NULL;
+    if (!slices) {
+        threads = 1;
+        slices = &single;
+    }
+    
+    // Slice 0 runs on this thread with the caller's stream; helpers get
+    // their own streams, so a seed and thread count reproduce the run
+    int started = 1;
+    int tail_begin = pop_size;
+    for (int t = 0; t < threads; t++) {
+        SeedSlice *slice = &slices[t];
+        slice->pop = pop;
+        slice->begin = (int)((long)pop_size * t / threads);
+        slice->end = (int)((long)pop_size * (t + 1) / threads);
+        slice->bounds = bounds;
+        slice->ctx = heuristics;
+        slice->robot_starts = robot_starts;
+        slice->robot_count = robot_count;
+        slice->survivor_count = survivor_count;
+        slice->cfg = cfg;
+        slice->rng = rng;
+        if (t == 0) continue;
         
-        // Shuffle the list for each chromosome
-        for (int s = survivor_count - 1; s > 0; s--) {
-            int j = rand() % (s + 1);
-            int temp = available_survivors[s];
-            available_survivors[s] = available_survivors[j];
-            available_survivors[j] = temp;
-        }
-
-        //  ensure each robot gets at least one survivor
-        int survivors_per_robot_base = survivor_count / robot_count;
-        int extra_survivors = survivor_count % robot_count;
-        int survivor_idx = 0;
-        
-        for (int r = 0; r < robot_count; r++) {
-            RobotMission *mission = &pop[i].missions[r];
-            mission->robot_pos = robot_starts ? robot_starts[r] : (Node){0, 0, 0};
-            
-            // Each robot gets base number of survivors and extra if available
-            int count = survivors_per_robot_base + (r < extra_survivors ? 1 : 0);
-            int max_per_robot = cfg->max_survivors_per_robot;
-            if (count > max_per_robot) count = max_per_robot;
-            
-            // Assign survivors in round-robin fashion
-            for (int s = 0; s < count && survivor_idx < survivor_count; s++) {
-                mission->survivor_sequence[s] = available_survivors[survivor_idx++];
-            }
-            
-            mission->survivor_count = count;
-            
-            // Fill remaining slots with -1
-            for (int s = count; s < max_per_robot; s++) {
-                mission->survivor_sequence[s] = -1;
-            }
+        rng_stream(&slice->own_rng, rng, t);
+        slice->rng = &slice->own_rng;
+        if (pthread_create(&slice->thread, NULL, seed_slice, slice) != 0) {
+            tail_begin = slice->begin;  // seeded below on this thread
+            break;
         }
-        
-        // distribute extra servivors to robots with fewer assignments
-        int max_per_robot_limit = cfg->max_survivors_per_robot;
-        while (survivor_idx < survivor_count) {
-            // Find robot with fewest assignments
-            int min_robot = 0;
-            int min_count = pop[i].missions[0].survivor_count;
-            for (int r = 1; r < robot_count; r++) {
-                if (pop[i].missions[r].survivor_count < min_count) {
-                    min_count = pop[i].missions[r].survivor_count;
-                    min_robot = r;
-                }
-            }
-            
-            if (min_count < max_per_robot_limit) {
-                pop[i].missions[min_robot].survivor_sequence[min_count] = available_survivors[survivor_idx++];
-                pop[i].missions[min_robot].survivor_count++;
-            } else {
-                break;
+        started++;
+    }
+    
+    seed_slice(&slices[0]);
+    if (tail_begin < pop_size) {
+        SeedSlice tail = slices[0];
+        tail.begin = tail_begin;
+        tail.end = pop_size;
+        seed_slice(&tail);
+    }
+    for (int t = 1; t < started; t++) {
+        pthread_join(slices[t].thread, NULL);
+    }
+    
+    if (slices != &single) free(slices);
+    
+    // Giant-tour individuals take their tour from the seeded missions and
+    // are decoded once, so genotype and phenotype agree from the start.
+    // The split needs a cost table covering the whole tour; without one the
+    // run keeps the mission encoding throughout.
+    if (pop[0].tour) {
+        if (cost_table_init(&pop[0], robot_count, survivor_count, cfg) == 0 &&
+            pop[0].tour_length <= cost_table_get()->survivor_count) {
+            for (int i = 0; i < pop_size; i++) {
+                tour_from_missions(&pop[i], robot_count);
+                tour_split(&pop[i], robot_count, cfg);
             }
+        } else {
+            fprintf(stderr, "Warning: giant-tour split unavailable, using the mission encoding\n");
+            tour_detach(pop, pop_size);
         }
-
-        pop[i].fitness = 0.0; 
+    }
+    if (heuristics) {
+        printf("Seeded population: %d nearest, %d sweep, %d regret, %d random\n",
+               bounds[0], bounds[1] - bounds[0], bounds[2] - bounds[1], pop_size - bounds[2]);
+        seed_context_free(&ctx);
     }
 }
 
@@ -171,52 +349,22 @@ static double euclidean_distance(Node a, Node b) {
     return sqrt(dx*dx + dy*dy + dz*dz);
 }
 
-static double fast_path_cost(Node start, Node end, const Config *cfg) {
-    if (building == NULL) {
-        return manhattan_distance(start, end);
-    }
-    
+// Path cost estimate of one leg from the voxels on its straight segment
+static double segment_cost(Node start, Node end, const SegmentTrace *trace, const Config *cfg) {
     // Use Euclidean distance as base
     double base_distance = euclidean_distance(start, end);
     if (base_distance < 0.1) return base_distance; // Same node
     
-    // Sample the path for obstacles and risk
-    // Sample more points for longer paths to maintain accuracy
-    int samples = (int)(base_distance * 2) + 3; // At least 3 samples
-    if (samples > 50) samples = 50;
-    
-    double obstacle_penalty = 0.0;
-    double risk_sum = 0.0;
-    int obstacle_count = 0;
-    int total_cells = 0;
-    
-    // Sample points along the straight-line path
-    for (int i = 0; i <= samples; i++) {
-        double t = (double)i / samples;
-        int x = (int)(start.x + t * (end.x - start.x) + 0.5);
-        int y = (int)(start.y + t * (end.y - start.y) + 0.5);
-        int z = (int)(start.z + t * (end.z - start.z) + 0.5);
-        
-        if (x < 0) x = 0;
-        if (x >= cfg->grid_x) x = cfg->grid_x - 1;
-        if (y < 0) y = 0;
-        if (y >= cfg->grid_y) y = cfg->grid_y - 1;
-        if (z < 0) z = 0;
-        if (z >= cfg->grid_z) z = cfg->grid_z - 1;
-        
-        total_cells++;
-        if (building[z][y][x].obstacle) {
-            obstacle_count++;
-            obstacle_penalty += 2.0; // Penalty for each obstacle
-        }
-        risk_sum += building[z][y][x].risk;
-    }
-    
-    double obstacle_density = (double)obstacle_count / total_cells;
+    double obstacle_penalty = trace->obstacles * 2.0; // Penalty for each obstacle
+    // A detour goes around whatever lies between the endpoints, so the
+    // density comes from the segment's bounding box rather than the line
+    RegionStats box = grid_box_stats(start, end, cfg);
+    double obstacle_density = box.cells > 0 ? (double)box.obstacles / box.cells
+                                            : (double)trace->obstacles / trace->cells;
     double detour_multiplier = 1.0 + (obstacle_density * 0.8); //  80% extra distance for high obstacle density
     
     // Calculate average risk
-    double avg_risk = risk_sum / total_cells;
+    double avg_risk = (double)trace->risk / trace->cells;
     
     // Estimated cost = base distance * detour_multiplier + obstacle penalties + risk factor
     double estimated_cost = base_distance * detour_multiplier + obstacle_penalty * 0.5 + avg_risk * 0.3;
@@ -224,172 +372,397 @@ static double fast_path_cost(Node start, Node end, const Config *cfg) {
     return estimated_cost;
 }
 
-double fitness_chromosome(const Chromosome *c, int robot_count, const Config *cfg) {
-    // Fitness weights
-    const double w1 = 100.0;   // Weight for unique survivors rescued
-    const double w2 = 200.0;   // Bonus if all survivors are assigned
-    const double w3 = 0.5;     // Weight for path length 
-    const double w4 = 5.0;     // Weight for risk exposure (penalty)
-    const double w5 = 50.0;    // Weight for collisions (penalty)
-    const double w6 = 150.0;   // Weight for duplicate assignments (penalty)
-    const double w7 = 200.0;   // Weight for valid paths 
-    const double w8 = 150.0;   // Bonus if all robots have at least one survivor
-    
-    Survivor survivors[1000]; 
-    int survivor_count = list_survivors(survivors, 1000, cfg);
-    
-    // unique survivors rescued
-    int unique_survivors = 0;
-    int max_survivor_id = -1;
-    int survivor_tracked[100] = {0};  // Track which survivors are rescued
-    
-    // find all survivors assigned to robots
-    for (int r = 0; r < robot_count; r++) {
-        RobotMission *mission = &c->missions[r];
-        for (int s = 0; s < mission->survivor_count; s++) {
-            int sid = mission->survivor_sequence[s];
-            if (sid >= 0 && sid < survivor_count) {
-                if (sid > max_survivor_id) {
-                    max_survivor_id = sid;
-                }
-                if (!survivor_tracked[sid]) {
-                    survivor_tracked[sid] = 1;
-                    unique_survivors++;
-                }
+// Survivor table used by the fitness kernel. The grid does not change after
+// detection, so it is listed once per process (fitness_survivors_init) and
+// only read afterwards, which keeps it safe to share between threads.
+static Survivor fitness_survivors[1000];
+static int fitness_survivor_count = 0;
+
+void fitness_survivors_init(const Config *cfg) {
+    fitness_survivor_count = list_survivors(fitness_survivors, 1000, cfg);
+}
+
+static const Survivor *fitness_survivor_table(int *count) {
+    *count = fitness_survivor_count;
+    return fitness_survivors;
+}
+
+// 0 if a visit starts or ends inside an obstacle
+static int visit_endpoints_valid(Node base, Node survivor_pos, const Config *cfg) {
+    // Check if path is valid 
+    // If start and end are both valid cells, assume path exists
+    int valid = 1;
+    if (building != NULL) {
+        // if start or end is obstacle, path is invalid
+        if (base.x >= 0 && base.x < cfg->grid_x &&
+            base.y >= 0 && base.y < cfg->grid_y &&
+            base.z >= 0 && base.z < cfg->grid_z) {
+            if (building[base.z][base.y][base.x].obstacle) {
+                valid = 0;
+            }
+        }
+        if (survivor_pos.x >= 0 && survivor_pos.x < cfg->grid_x &&
+            survivor_pos.y >= 0 && survivor_pos.y < cfg->grid_y &&
+            survivor_pos.z >= 0 && survivor_pos.z < cfg->grid_z) {
+            if (building[survivor_pos.z][survivor_pos.y][survivor_pos.x].obstacle) {
+                valid = 0;
             }
         }
     }
     
-    //Calculate total path length and risk using FAST HEURISTIC
+    return valid;
+}
+
+// Length and risk of one survivor visit from a robot's base. Every visit is
+// a round trip, so a mission's score is the sum of its visits. Returns 1 if
+// the path is usable, 0 if it starts or ends inside an obstacle (the length
+// then holds the penalty instead).
+// The trace is of the segment between them; both legs of the round trip
+// follow it, so it is traced once and counted twice.
+static int score_traced_visit(Node base, Node survivor_pos, const SegmentTrace *trace,
+                              const Config *cfg, double *length, double *risk) {
+    *length = 0.0;
+    *risk = 0.0;
+    
+    if (!visit_endpoints_valid(base, survivor_pos, cfg)) {
+        // Invalid path use large penalty
+        *length = manhattan_distance(base, survivor_pos) * 3.0;
+        return 0;
+    }
+    if (building == NULL) {
+        *length = 2.0 * manhattan_distance(base, survivor_pos);
+        return 1;
+    }
+    
+    *length = 2.0 * segment_cost(base, survivor_pos, trace, cfg);
+    *risk = 2.0 * trace->risk;
+    return 1;
+}
+
+static int score_visit(Node base, Node survivor_pos, const Config *cfg, double *length, double *risk) {
+    SegmentTrace trace;
+    dda_trace(base, survivor_pos, cfg, &trace);
+    return score_traced_visit(base, survivor_pos, &trace, cfg, length, risk);
+}
+
+// score_visit with the exact shortest-path length from the path service in
+// place of the straight-line estimate. A survivor the base cannot reach
+// counts as an invalid path.
+static int score_visit_exact(Node base, Node survivor_pos, const Config *cfg, double *length, double *risk) {
+    *length = 0.0;
+    *risk = 0.0;
+    
+    int steps = visit_endpoints_valid(base, survivor_pos, cfg) ?
+                path_service_length(base, survivor_pos, cfg) : -1;
+    if (steps < 0) {
+        *length = manhattan_distance(base, survivor_pos) * 3.0;
+        return 0;
+    }
+    
+    SegmentTrace trace;
+    dda_trace(base, survivor_pos, cfg, &trace);
+    *length = 2.0 * steps;
+    *risk = 2.0 * trace.risk;
+    return 1;
+}
+
+// Visits traced together by score_mission
+#define MISSION_TRACE_BATCH (4 * DDA_LANES)
+
+// Path length, risk and valid path count of one robot mission
+static void score_mission(Node base, const int sequence[], int visit_count,
+                          const Survivor survivors[], int survivor_count,
+                          const Config *cfg, MissionScore *out) {
     double total_length = 0.0;
     double total_risk = 0.0;
     int valid_paths = 0;
     
-    for (int r = 0; r < robot_count; r++) {
-        RobotMission *mission = &c->missions[r];
-        Node current_pos = mission->robot_pos;  // Start at robot position
+    // Trace the mission's visits in batches, then score them in sequence
+    Node bases[MISSION_TRACE_BATCH];
+    Node goals[MISSION_TRACE_BATCH];
+    SegmentTrace traces[MISSION_TRACE_BATCH];
+    for (int i = 0; i < MISSION_TRACE_BATCH; i++) {
+        bases[i] = base;
+    }
+    
+    for (int first = 0; first < visit_count; first += MISSION_TRACE_BATCH) {
+        int end = first + MISSION_TRACE_BATCH;
+        if (end > visit_count) end = visit_count;
         
-        // For each survivor in sequence
-        for (int s = 0; s < mission->survivor_count; s++) {
-            int sid = mission->survivor_sequence[s];
+        int count = 0;
+        for (int s = first; s < end; s++) {
+            int sid = sequence[s];
             if (sid >= 0 && sid < survivor_count) {
-                Node survivor_pos = survivors[sid].pos;
-                
-                double outbound_cost = fast_path_cost(current_pos, survivor_pos, cfg);
-                double return_cost = fast_path_cost(survivor_pos, mission->robot_pos, cfg);
-                
-                // Check if path is valid 
-                // If start and end are both valid cells, assume path exists
-                int valid = 1;
-                if (building != NULL) {
-                    // if start or end is obstacle, path is invalid
-                    if (current_pos.x >= 0 && current_pos.x < cfg->grid_x &&
-                        current_pos.y >= 0 && current_pos.y < cfg->grid_y &&
-                        current_pos.z >= 0 && current_pos.z < cfg->grid_z) {
-                        if (building[current_pos.z][current_pos.y][current_pos.x].obstacle) {
-                            valid = 0;
-                        }
-                    }
-                    if (survivor_pos.x >= 0 && survivor_pos.x < cfg->grid_x &&
-                        survivor_pos.y >= 0 && survivor_pos.y < cfg->grid_y &&
-                        survivor_pos.z >= 0 && survivor_pos.z < cfg->grid_z) {
-                        if (building[survivor_pos.z][survivor_pos.y][survivor_pos.x].obstacle) {
-                            valid = 0;
-                        }
-                    }
-                }
-                
-                if (valid) {
-                    valid_paths++;
-                    total_length += outbound_cost + return_cost;
-                    
-                    // Estimate risk: sample a few points along the path
-                    if (building != NULL) {
-                        int samples = 10;
-                        for (int i = 0; i <= samples; i++) {
-                            double t = (double)i / samples;
-                            int x1 = (int)(current_pos.x + t * (survivor_pos.x - current_pos.x) + 0.5);
-                            int y1 = (int)(current_pos.y + t * (survivor_pos.y - current_pos.y) + 0.5);
-                            int z1 = (int)(current_pos.z + t * (survivor_pos.z - current_pos.z) + 0.5);
-                            int x2 = (int)(survivor_pos.x + t * (mission->robot_pos.x - survivor_pos.x) + 0.5);
-                            int y2 = (int)(survivor_pos.y + t * (mission->robot_pos.y - survivor_pos.y) + 0.5);
-                            int z2 = (int)(survivor_pos.z + t * (mission->robot_pos.z - survivor_pos.z) + 0.5);
-                            
-                            // Clamp and sample
-                            if (x1 >= 0 && x1 < cfg->grid_x && y1 >= 0 && y1 < cfg->grid_y && 
-                                z1 >= 0 && z1 < cfg->grid_z) {
-                                total_risk += building[z1][y1][x1].risk;
-                            }
-                            if (x2 >= 0 && x2 < cfg->grid_x && y2 >= 0 && y2 < cfg->grid_y && 
-                                z2 >= 0 && z2 < cfg->grid_z) {
-                                total_risk += building[z2][y2][x2].risk;
-                            }
-                        }
-                    }
-                    
-                    current_pos = mission->robot_pos;
-                } else {
-                    // Invalid path use large penalty
-                    total_length += manhattan_distance(current_pos, survivor_pos) * 3.0;
-                }
+                goals[count++] = survivors[sid].pos;
             }
         }
+        dda_trace_batch(bases, goals, count, cfg, traces);
+        
+        for (int k = 0; k < count; k++) {
+            double length, risk;
+            valid_paths += score_traced_visit(base, goals[k], &traces[k], cfg, &length, &risk);
+            total_length += length;
+            total_risk += risk;
+        }
     }
     
-    int collisions = detect_collisions(c, robot_count);
+    out->length = total_length;
+    out->risk = total_risk;
+    out->valid_paths = valid_paths;
+    out->dirty = 0;
+}
+
+// Fitness weights
+static const double w1 = 100.0;   // Weight for unique survivors rescued
+static const double w2 = 200.0;   // Bonus if all survivors are assigned
+static const double w3 = 0.5;     // Weight for path length 
+static const double w4 = 5.0;     // Weight for risk exposure (penalty)
+static const double w5 = 50.0;    // Weight for collisions (penalty)
+static const double w6 = 150.0;   // Weight for duplicate assignments (penalty)
+static const double w7 = 200.0;   // Weight for valid paths 
+static const double w8 = 150.0;   // Bonus if all robots have at least one survivor
+
+int fitness_survivor_total(void) {
+    return fitness_survivor_count;
+}
+
+double fitness_visit_value(Node base, int sid, const Config *cfg) {
+    int survivor_count;
+    const Survivor *survivors = fitness_survivor_table(&survivor_count);
+    if (sid < 0 || sid >= survivor_count) return 0.0;
     
-    // Calculate duplicate survivor assignments 
-    int duplicate_assignments = 0;
-    if (max_survivor_id >= 0) {
-        int *survivor_assignment_count = calloc(max_survivor_id + 1, sizeof(int));
-        if (survivor_assignment_count) {
-            for (int r = 0; r < robot_count; r++) {
-                RobotMission *mission = &c->missions[r];
-                for (int s = 0; s < mission->survivor_count; s++) {
-                    int sid = mission->survivor_sequence[s];
-                    if (sid >= 0 && sid <= max_survivor_id) {
-                        survivor_assignment_count[sid]++;
-                    }
-                }
-            }
-            for (int i = 0; i <= max_survivor_id; i++) {
-                if (survivor_assignment_count[i] > 1) {
-                    duplicate_assignments += (survivor_assignment_count[i] - 1);
-                }
-            }
-            free(survivor_assignment_count);
+    double length, risk;
+    int valid = score_visit(base, survivors[sid].pos, cfg, &length, &risk);
+    return w7 * valid - w3 * length - w4 * risk;
+}
+
+// Per-thread stamped survivor set for counting unique/duplicate assignments
+static __thread unsigned int *seen_stamp = NULL;
+static __thread int seen_capacity = 0;
+static __thread unsigned int seen_epoch = 0;
+
+// Assignment-level counts gathered one mission at a time
+typedef struct {
+    int unique_survivors;
+    int duplicate_assignments;
+    int active_robots;
+} AssignmentTally;
+
+static void tally_begin(AssignmentTally *t, int survivor_count) {
+    if (survivor_count > seen_capacity) {
+        unsigned int *stamp = realloc(seen_stamp, survivor_count * sizeof(unsigned int));
+        if (stamp) {
+            memset(stamp, 0, survivor_count * sizeof(unsigned int));
+            seen_stamp = stamp;
+            seen_capacity = survivor_count;
+            seen_epoch = 0;
         }
     }
-    
-    // Count robots with assignments
-    int active_robots = 0;
-    for (int r = 0; r < robot_count; r++) {
-        if (c->missions[r].survivor_count > 0) {
-            active_robots++;
+    if (++seen_epoch == 0) {
+        memset(seen_stamp, 0, seen_capacity * sizeof(unsigned int));
+        seen_epoch = 1;
+    }
+    t->unique_survivors = 0;
+    t->duplicate_assignments = 0;
+    t->active_robots = 0;
+}
+
+// Unique survivors rescued and duplicate survivor assignments
+static void tally_mission(AssignmentTally *t, const int sequence[], int visit_count, int survivor_count) {
+    if (visit_count > 0) {
+        t->active_robots++;
+    }
+    for (int s = 0; s < visit_count; s++) {
+        int sid = sequence[s];
+        if (sid >= 0 && sid < survivor_count && sid < seen_capacity) {
+            if (seen_stamp[sid] != seen_epoch) {
+                seen_stamp[sid] = seen_epoch;
+                t->unique_survivors++;
+            } else {
+                t->duplicate_assignments++;
+            }
         }
     }
-    
+}
+
+// Combine summed mission terms with the assignment-level terms into the fitness
+static double combine_fitness(const AssignmentTally *t, int collisions, int robot_count, int survivor_count,
+                              double total_length, double total_risk, int valid_paths,
+                              const Config *cfg) {
     // Calculate maximum assignable survivors
     int max_assignable = cfg->max_survivors_per_robot * robot_count;
     int target_survivors = (survivor_count < max_assignable) ? survivor_count : max_assignable;
     
-    double all_survivors_bonus = (unique_survivors >= target_survivors) ? w2 : 0.0;
-    double all_robots_bonus = (active_robots == robot_count) ? w8 : 0.0;
+    double all_survivors_bonus = (t->unique_survivors >= target_survivors) ? w2 : 0.0;
+    double all_robots_bonus = (t->active_robots == robot_count) ? w8 : 0.0;
     
   
     // f = w1*unique_survivors + w2*all_survivors_bonus - w3*length - w4*risk - w5*collisions - w6*duplicates + w7*valid_paths + w8*all_robots_bonus
-    double fitness = w1 * unique_survivors + 
+    double fitness = w1 * t->unique_survivors + 
                      w2 * all_survivors_bonus -
                      w3 * total_length - 
                      w4 * total_risk - 
                      w5 * collisions - 
-                     w6 * duplicate_assignments +
+                     w6 * t->duplicate_assignments +
                      w7 * valid_paths +
                      all_robots_bonus;
     
     return fitness;
 }
 
+double fitness_chromosome(const Chromosome *c, int robot_count, const Config *cfg) {
+    int survivor_count;
+    const Survivor *survivors = fitness_survivor_table(&survivor_count);
+    
+    //Calculate total path length and risk using FAST HEURISTIC
+    double total_length = 0.0;
+    double total_risk = 0.0;
+    int valid_paths = 0;
+    AssignmentTally tally;
+    tally_begin(&tally, survivor_count);
+    
+    for (int r = 0; r < robot_count; r++) {
+        const RobotMission *mission = &c->missions[r];
+        MissionScore score;
+        score_mission(mission->robot_pos, mission->survivor_sequence, mission->survivor_count,
+                      survivors, survivor_count, cfg, &score);
+        total_length += score.length;
+        total_risk += score.risk;
+        valid_paths += score.valid_paths;
+        tally_mission(&tally, mission->survivor_sequence, mission->survivor_count, survivor_count);
+    }
+    
+    return combine_fitness(&tally, detect_collisions(c, robot_count), robot_count, survivor_count,
+                           total_length, total_risk, valid_paths, cfg);
+}
+
+double fitness_chromosome_cached(Chromosome *c, int robot_count, const Config *cfg) {
+    c->fidelity = FIDELITY_ESTIMATE;
+    if (!c->scores) return fitness_chromosome(c, robot_count, cfg);
+    
+    int survivor_count;
+    const Survivor *survivors = fitness_survivor_table(&survivor_count);
+    
+    // Rescore only missions touched by crossover, mutation or repair
+    double total_length = 0.0;
+    double total_risk = 0.0;
+    int valid_paths = 0;
+    AssignmentTally tally;
+    tally_begin(&tally, survivor_count);
+    
+    for (int r = 0; r < robot_count; r++) {
+        const RobotMission *mission = &c->missions[r];
+        MissionScore *score = &c->scores[r];
+        if (score->dirty) {
+            score_mission(mission->robot_pos, mission->survivor_sequence, mission->survivor_count,
+                          survivors, survivor_count, cfg, score);
+        }
+        total_length += score->length;
+        total_risk += score->risk;
+        valid_paths += score->valid_paths;
+        tally_mission(&tally, mission->survivor_sequence, mission->survivor_count, survivor_count);
+    }
+    
+    return combine_fitness(&tally, detect_collisions(c, robot_count), robot_count, survivor_count,
+                           total_length, total_risk, valid_paths, cfg);
+}
+
+double fitness_view_cached(const ChromosomeView *v, MissionScore scores[], int robot_count,
+                           const Config *cfg) {
+    int survivor_count;
+    const Survivor *survivors = fitness_survivor_table(&survivor_count);
+    
+    double total_length = 0.0;
+    double total_risk = 0.0;
+    int valid_paths = 0;
+    int collisions = 0;
+    AssignmentTally tally;
+    tally_begin(&tally, survivor_count);
+    
+    for (int r = 0; r < robot_count; r++) {
+        const int *sequence = &v->sequences[(size_t)r * v->stride];
+        int visit_count = v->survivor_counts[r];
+        if (visit_count > v->stride) visit_count = v->stride;
+        
+        MissionScore *score = &scores[r];
+        if (score->dirty) {
+            score_mission(v->robot_pos[r], sequence, visit_count, survivors, survivor_count, cfg, score);
+        }
+        total_length += score->length;
+        total_risk += score->risk;
+        valid_paths += score->valid_paths;
+        tally_mission(&tally, sequence, visit_count, survivor_count);
+        
+        for (int other = r + 1; other < robot_count; other++) {
+            Node a = v->robot_pos[r];
+            Node b = v->robot_pos[other];
+            if (a.x == b.x && a.y == b.y && a.z == b.z) collisions++;
+        }
+    }
+    
+    return combine_fitness(&tally, collisions, robot_count, survivor_count,
+                           total_length, total_risk, valid_paths, cfg);
+}
+
+double fitness_chromosome_exact(const Chromosome *c, int robot_count, const Config *cfg) {
+    int survivor_count;
+    const Survivor *survivors = fitness_survivor_table(&survivor_count);
+    
+    // Mission score caches hold estimate terms, so they are left untouched
+    double total_length = 0.0;
+    double total_risk = 0.0;
+    int valid_paths = 0;
+    AssignmentTally tally;
+    tally_begin(&tally, survivor_count);
+    
+    for (int r = 0; r < robot_count; r++) {
+        const RobotMission *mission = &c->missions[r];
+        tally_mission(&tally, mission->survivor_sequence, mission->survivor_count, survivor_count);
+        for (int s = 0; s < mission->survivor_count; s++) {
+            int sid = mission->survivor_sequence[s];
+            if (sid >= 0 && sid < survivor_count) {
+                double length, risk;
+                valid_paths += score_visit_exact(mission->robot_pos, survivors[sid].pos, cfg, &length, &risk);
+                total_length += length;
+                total_risk += risk;
+            }
+        }
+    }
+    
+    return combine_fitness(&tally, detect_collisions(c, robot_count), robot_count, survivor_count,
+                           total_length, total_risk, valid_paths, cfg);
+}
+
+int fitness_refine_top(Chromosome pop[], int pop_size, int top_k, int elite_count,
+                       int robot_count, const Config *cfg) {
+    if (!pop || pop_size <= 0 || top_k <= 0) return 0;
+    
+    if (elite_count > pop_size) elite_count = pop_size;
+    
+    // The top_k best estimates are rescored even when exact elites rank
+    // above them; otherwise a bias between the two fidelities would keep
+    // new children from ever being checked
+    int budget = top_k;
+    int refined = 0;
+    for (;;) {
+        int rescored = 0;
+        for (int i = 0; i < pop_size; i++) {
+            Chromosome *c = &pop[i];
+            if (!c->fitness_valid || c->fidelity == FIDELITY_EXACT) continue;
+            if (i >= elite_count && rescored >= budget) break;
+            c->fitness = fitness_chromosome_exact(c, robot_count, cfg);
+            c->fidelity = FIDELITY_EXACT;
+            rescored++;
+        }
+        if (rescored == 0) break;
+        refined += rescored;
+        sort_by_fitness(pop, pop_size);
+        // Re-sorting can lift estimates into the elite ranks; score those too
+        budget = 0;
+    }
+    return refined;
+}
+
 int detect_collisions(const Chromosome *c, int robot_count) {
     if (!c) return 0;
     
@@ -410,41 +783,120 @@ int detect_collisions(const Chromosome *c, int robot_count) {
     return collisions;
 }
 
+uint64_t chromosome_hash(const Chromosome *c, int robot_count) {
+    // FNV-1a over 32-bit gene words, finished with a 64-bit avalanche
+    uint64_t h = 0xcbf29ce484222325ULL;
+    const uint64_t prime = 0x100000001b3ULL;
+    
+    for (int r = 0; r < robot_count; r++) {
+        const RobotMission *mission = &c->missions[r];
+        h = (h ^ (uint32_t)mission->robot_pos.x) * prime;
+        h = (h ^ (uint32_t)mission->robot_pos.y) * prime;
+        h = (h ^ (uint32_t)mission->robot_pos.z) * prime;
+        h = (h ^ (uint32_t)mission->survivor_count) * prime;
+        for (int s = 0; s < mission->survivor_count; s++) {
+            h = (h ^ (uint32_t)mission->survivor_sequence[s]) * prime;
+        }
+    }
+    
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
 void tournament_select(const Chromosome pop[], int pop_size,
-                       Chromosome parents[], int parent_count, int robot_count) {
-    if (!pop || !parents || pop_size <= 0 || parent_count <= 0) return;
+                       int parent_idx[], int parent_count, Rng *rng) {
+    if (!pop || !parent_idx || pop_size <= 0 || parent_count <= 0) return;
     
     const int tournament_size = 3;  
     
     for (int i = 0; i < parent_count; i++) {
 
-        int best_idx = rand() % pop_size;
+        int best_idx = rng_below(rng, pop_size);
         double best_fitness = pop[best_idx].fitness;
         
         for (int j = 1; j < tournament_size; j++) {
-            int candidate_idx = rand() % pop_size;
+            int candidate_idx = rng_below(rng, pop_size);
             if (pop[candidate_idx].fitness > best_fitness) {
                 best_idx = candidate_idx;
                 best_fitness = pop[candidate_idx].fitness;
             }
         }
         
-        if (parents[i].missions && pop[best_idx].missions) {
-            for (int r = 0; r < robot_count; r++) {
-                parents[i].missions[r] = pop[best_idx].missions[r];
-            }
-            parents[i].fitness = pop[best_idx].fitness;
-        }
+        parent_idx[i] = best_idx;
+    }
+}
+
+// Per-thread scratch reused by every repair_chromosome call on that thread.
+// A survivor is marked assigned when stamp[sid] == epoch, so clearing the
+// set between calls is a single epoch increment instead of a calloc.
+typedef struct {
+    unsigned int *stamp;
+    int stamp_capacity;
+    unsigned int epoch;
+    int *heap;              // robot indices, min-heap on (survivor_count, index)
+    int heap_capacity;
+} RepairScratch;
+
+static __thread RepairScratch repair_scratch = {0};
+
+static int repair_scratch_reserve(RepairScratch *rs, int survivor_count, int robot_count) {
+    if (survivor_count > rs->stamp_capacity) {
+        unsigned int *stamp = realloc(rs->stamp, survivor_count * sizeof(unsigned int));
+        if (!stamp) return -1;
+        memset(stamp, 0, survivor_count * sizeof(unsigned int));
+        rs->stamp = stamp;
+        rs->stamp_capacity = survivor_count;
+        rs->epoch = 0;
+    }
+    if (robot_count > rs->heap_capacity) {
+        int *heap = realloc(rs->heap, robot_count * sizeof(int));
+        if (!heap) return -1;
+        rs->heap = heap;
+        rs->heap_capacity = robot_count;
+    }
+    
+    // New epoch; on wrap-around old stamps could collide, so clear them once
+    if (++rs->epoch == 0) {
+        memset(rs->stamp, 0, rs->stamp_capacity * sizeof(unsigned int));
+        rs->epoch = 1;
+    }
+    return 0;
+}
+
+// Heap order: fewer survivors first, lower robot index on ties
+static int load_less(const Chromosome *c, int a, int b) {
+    int ca = c->missions[a].survivor_count;
+    int cb = c->missions[b].survivor_count;
+    return ca < cb || (ca == cb && a < b);
+}
+
+static void load_heap_sift_down(int heap[], int n, int i, const Chromosome *c) {
+    while (1) {
+        int smallest = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        if (left < n && load_less(c, heap[left], heap[smallest])) smallest = left;
+        if (right < n && load_less(c, heap[right], heap[smallest])) smallest = right;
+        if (smallest == i) return;
+        int temp = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = temp;
+        i = smallest;
     }
 }
 
 // Repair chromosome to remove duplicate survivor assignments
 static void repair_chromosome(Chromosome *c, int robot_count, int survivor_count, int max_survivors_per_robot) {
-    if (!c || survivor_count <= 0) return;
+    if (!c || survivor_count <= 0 || robot_count <= 0) return;
     
-    // Track which survivors have been assigned
-    int *assigned = calloc(survivor_count, sizeof(int));
-    if (!assigned) return;
+    RepairScratch *rs = &repair_scratch;
+    if (repair_scratch_reserve(rs, survivor_count, robot_count) != 0) return;
+    unsigned int *stamp = rs->stamp;
+    unsigned int epoch = rs->epoch;
     
     for (int r = 0; r < robot_count; r++) {
         RobotMission *mission = &c->missions[r];
@@ -452,48 +904,56 @@ static void repair_chromosome(Chromosome *c, int robot_count, int survivor_count
         
         for (int s = 0; s < mission->survivor_count; s++) {
             int sid = mission->survivor_sequence[s];
-            if (sid >= 0 && sid < survivor_count && !assigned[sid]) {
-                assigned[sid] = 1;
+            if (sid >= 0 && sid < survivor_count && stamp[sid] != epoch) {
+                stamp[sid] = epoch;
                 mission->survivor_sequence[new_count++] = sid;
             }
         }
         
+        if (new_count != mission->survivor_count) {
+            mark_mission_dirty(c, r);
+        }
         mission->survivor_count = new_count;
         for (int s = new_count; s < max_survivors_per_robot; s++) {
             mission->survivor_sequence[s] = -1;
         }
     }
     
-    //  assign unassigned survivors to robots with fewest assignments
-    for (int sid = 0; sid < survivor_count; sid++) {
-        if (!assigned[sid]) {
-            // Find robot with fewest survivors
-            int min_robot = 0;
-            int min_count = c->missions[0].survivor_count;
-            for (int r = 1; r < robot_count; r++) {
-                if (c->missions[r].survivor_count < min_count) {
-                    min_count = c->missions[r].survivor_count;
-                    min_robot = r;
-                }
-            }
-            
-            if (min_count < max_survivors_per_robot) {
-                c->missions[min_robot].survivor_sequence[min_count] = sid;
-                c->missions[min_robot].survivor_count++;
-                assigned[sid] = 1;
-            }
+    // Heap of robots that still have capacity, least loaded on top
+    int *heap = rs->heap;
+    int heap_size = 0;
+    for (int r = 0; r < robot_count; r++) {
+        if (c->missions[r].survivor_count < max_survivors_per_robot) {
+            heap[heap_size++] = r;
         }
     }
+    for (int i = heap_size / 2 - 1; i >= 0; i--) {
+        load_heap_sift_down(heap, heap_size, i, c);
+    }
     
-    free(assigned);
+    //  assign unassigned survivors to robots with fewest assignments
+    for (int sid = 0; sid < survivor_count && heap_size > 0; sid++) {
+        if (stamp[sid] == epoch) continue;
+        
+        RobotMission *mission = &c->missions[heap[0]];
+        mission->survivor_sequence[mission->survivor_count++] = sid;
+        stamp[sid] = epoch;
+        mark_mission_dirty(c, heap[0]);
+        
+        // Full robots leave the heap, others sink to their new position
+        if (mission->survivor_count >= max_survivors_per_robot) {
+            heap[0] = heap[--heap_size];
+        }
+        load_heap_sift_down(heap, heap_size, 0, c);
+    }
 }
 
 void crossover(Chromosome *child, const Chromosome *p1, const Chromosome *p2,
-               int robot_count, int survivor_count, int max_survivors_per_robot) {
+               int robot_count, int survivor_count, int max_survivors_per_robot, Rng *rng) {
     if (!child || !p1 || !p2) return;
     
     // randomly choose a crossover point
-    int crossover_point = rand() % robot_count;
+    int crossover_point = rng_below(rng, robot_count);
     
   
     for (int r = 0; r < robot_count; r++) {
@@ -506,6 +966,9 @@ void crossover(Chromosome *child, const Chromosome *p1, const Chromosome *p2,
         for (int s = 0; s < max_survivors_per_robot; s++) {
             child_mission->survivor_sequence[s] = parent_mission->survivor_sequence[s];
         }
+        
+        // Mission is unchanged, so the parent's cached score carries over
+        child->scores[r] = (r < crossover_point) ? p1->scores[r] : p2->scores[r];
     }
     
     // Repair to remove duplicate survivor assignments
@@ -513,11 +976,12 @@ void crossover(Chromosome *child, const Chromosome *p1, const Chromosome *p2,
     
     // Reset fitness 
     child->fitness = 0.0;
+    child->fitness_valid = 0;
 }
 
 void mutate(Chromosome *c, int robot_count, double rate, 
             const Node robot_starts[], const Survivor survivors[], 
-            int survivor_count, const Config *cfg) {
+            int survivor_count, const Config *cfg, Rng *rng) {
     if (!c || !cfg || survivor_count == 0) return;
     
     (void)robot_starts;
@@ -526,24 +990,25 @@ void mutate(Chromosome *c, int robot_count, double rate,
     
     for (int r = 0; r < robot_count; r++) {
         // Random mutation decision
-        if ((double)rand() / RAND_MAX < rate) {
+        if (rng_uniform(rng) < rate) {
             RobotMission *mission = &c->missions[r];
             mutated = 1;
+            mark_mission_dirty(c, r);
             
             // Change the sequence of survivors
             if (mission->survivor_count > 0) {
-                int mutation_type = rand() % 4;
+                int mutation_type = rng_below(rng, 4);
                 
                 if (mutation_type == 0 && mission->survivor_count > 1) {
                     // Swap two survivors in this robot's sequence
-                    int idx1 = rand() % mission->survivor_count;
-                    int idx2 = rand() % mission->survivor_count;
+                    int idx1 = rng_below(rng, mission->survivor_count);
+                    int idx2 = rng_below(rng, mission->survivor_count);
                     int temp = mission->survivor_sequence[idx1];
                     mission->survivor_sequence[idx1] = mission->survivor_sequence[idx2];
                     mission->survivor_sequence[idx2] = temp;
                 } else if (mutation_type == 1 && mission->survivor_count > 1) {
                     // Remove a random survivor from sequence
-                    int remove_idx = rand() % mission->survivor_count;
+                    int remove_idx = rng_below(rng, mission->survivor_count);
                     for (int i = remove_idx; i < mission->survivor_count - 1; i++) {
                         mission->survivor_sequence[i] = mission->survivor_sequence[i + 1];
                     }
@@ -551,8 +1016,9 @@ void mutate(Chromosome *c, int robot_count, double rate,
                     mission->survivor_count--;
                 } else if (mutation_type == 2 && robot_count > 1) {
                     // Move a survivor to another robot
-                    int other_robot = rand() % robot_count;
-                    while (other_robot == r) other_robot = rand() % robot_count;
+                    // Any robot but r, in a single draw
+                    int other_robot = rng_below(rng, robot_count - 1);
+                    if (other_robot >= r) other_robot++;
                     
                     RobotMission *other = &c->missions[other_robot];
                     // Check limit
@@ -563,11 +1029,12 @@ void mutate(Chromosome *c, int robot_count, double rate,
                         mission->survivor_count--;
                         other->survivor_sequence[other->survivor_count] = sid;
                         other->survivor_count++;
+                        mark_mission_dirty(c, other_robot);
                     }
                 } else if (mutation_type == 3 && mission->survivor_count > 1) {
                     // Reverse a portion of the sequence
-                    int start = rand() % mission->survivor_count;
-                    int end = rand() % mission->survivor_count;
+                    int start = rng_below(rng, mission->survivor_count);
+                    int end = rng_below(rng, mission->survivor_count);
                     if (start > end) { int t = start; start = end; end = t; }
                     while (start < end) {
                         int temp = mission->survivor_sequence[start];
@@ -587,6 +1054,34 @@ void mutate(Chromosome *c, int robot_count, double rate,
     
     // Reset fitness
     c->fitness = 0.0;
+    c->fitness_valid = 0;
+}
+
+void breed_child(Chromosome *child, const Chromosome *p1, const Chromosome *p2,
+                 int robot_count, int survivor_count, double mutation_rate,
+                 const Node robot_starts[], const Survivor survivors[],
+                 const Config *cfg, int improve, Rng *rng) {
+    if (child->tour && p1->tour && p2->tour) {
+        // Robot bases are not part of the tour; they come from the first parent
+        for (int r = 0; r < robot_count; r++) {
+            child->missions[r].robot_pos = p1->missions[r].robot_pos;
+        }
+        tour_crossover(child, p1, p2, rng);
+        tour_mutate(child, robot_count, mutation_rate, rng);
+        if (tour_split(child, robot_count, cfg) != 0) {
+            // Parents on other bases than the cost table: breed the missions
+            crossover(child, p1, p2, robot_count, survivor_count, cfg->max_survivors_per_robot, rng);
+            mutate(child, robot_count, mutation_rate, robot_starts, survivors, survivor_count, cfg, rng);
+            tour_from_missions(child, robot_count);
+        }
+    } else {
+        crossover(child, p1, p2, robot_count, survivor_count, cfg->max_survivors_per_robot, rng);
+        mutate(child, robot_count, mutation_rate, robot_starts, survivors, survivor_count, cfg, rng);
+    }
+    
+    if (improve) {
+        local_search(child, robot_count, cfg);
+    }
 }
 
 void sort_by_fitness(Chromosome pop[], int pop_size) {
@@ -604,113 +1099,342 @@ void sort_by_fitness(Chromosome pop[], int pop_size) {
     }
 }
 
+// Breeding job for the thread pool. The children are cut into a fixed
+// number of slices, each with its own RNG stream, and every slice is one
+// pool chunk. Whichever thread ends up running a slice, a run with the same
+// seed and BREED_THREADS is reproducible.
+typedef struct {
+    ThreadPool *pool;
+    int slice_count;
+    Rng *caller_rng;            // slice 0 draws from the caller's stream
+    Rng *streams;               // slices 1..slice_count-1
+    
+    // Current generation
+    const Chromosome *pop;
+    Chromosome *new_pop;
+    int *parent_idx;
+    int pop_size;
+    int elite_count;
+    int robot_count;
+    int survivor_count;
+    double mutation_rate;
+    const Node *robot_starts;
+    const Survivor *survivors;
+    const Config *cfg;
+} BreedJob;
+
+void ga_release_thread_scratch(void) {
+    free(repair_scratch.stamp);
+    free(repair_scratch.heap);
+    repair_scratch = (RepairScratch){0};
+    free(seen_stamp);
+    seen_stamp = NULL;
+    seen_capacity = 0;
+    seen_epoch = 0;
+    local_search_release_thread_scratch();
+    tour_release_thread_scratch();
+}
+
+// Select, cross and mutate the children in one slice
+static void breed_slice(BreedJob *job, int slice) {
+    int child_count = job->pop_size - job->elite_count;
+    int begin = (int)((long)child_count * slice / job->slice_count);
+    int end = (int)((long)child_count * (slice + 1) / job->slice_count);
+    if (begin >= end) return;
+    Rng *rng = slice == 0 ? job->caller_rng : &job->streams[slice];
+    
+    // Parent pairs for the whole slice are drawn up front
+    tournament_select(job->pop, job->pop_size, &job->parent_idx[2 * begin], 2 * (end - begin), rng);
+    
+    for (int k = begin; k < end; k++) {
+        Chromosome *child = &job->new_pop[job->elite_count + k];
+        const int *pair = &job->parent_idx[2 * k];
+        
+        breed_child(child, &job->pop[pair[0]], &job->pop[pair[1]], job->robot_count,
+                    job->survivor_count, job->mutation_rate, job->robot_starts, job->survivors,
+                    job->cfg, job->cfg->local_search & LOCAL_SEARCH_CHILDREN, rng);
+    }
+}
+
+static void breed_slices(void *arg, int begin, int end) {
+    for (int slice = begin; slice < end; slice++) {
+        breed_slice(arg, slice);
+    }
+}
+
+static int breed_job_start(BreedJob *job, int slice_count, Rng *rng) {
+    memset(job, 0, sizeof(*job));
+    if (slice_count < 1) slice_count = 1;
+    
+    job->streams = calloc(slice_count, sizeof(Rng));
+    if (!job->streams) return -1;
+    for (int s = 1; s < slice_count; s++) {
+        rng_stream(&job->streams[s], rng, s);
+    }
+    job->pool = thread_pool_create(slice_count);
+    if (!job->pool) {
+        free(job->streams);
+        return -1;
+    }
+    job->slice_count = slice_count;
+    job->caller_rng = rng;
+    return 0;
+}
+
+static void breed_job_run(BreedJob *job) {
+    thread_pool_run(job->pool, job->slice_count, 1, breed_slices, job);
+}
+
+static void breed_job_stop(BreedJob *job) {
+    thread_pool_destroy(job->pool);
+    free(job->streams);
+}
+
+// Carry the elites of the sorted cur into the first elite_count slots of next
+static void preserve_elites(Chromosome next[], const Chromosome cur[], int elite_count,
+                            int robot_count, const Config *cfg) {
+    for (int i = 0; i < elite_count; i++) {
+        // Deep copy elite chromosome
+        copy_chromosome(&next[i], &cur[i], robot_count, cfg->max_survivors_per_robot);
+        
+        if ((cfg->local_search & LOCAL_SEARCH_ELITES) && local_search(&next[i], robot_count, cfg) > 0) {
+            next[i].fitness = fitness_chromosome_cached(&next[i], robot_count, cfg);
+            next[i].fitness_valid = 1;
+        }
+    }
+}
+
 void evolve_loop(int generations, Chromosome pop[], int pop_size,
                  int robot_count, double mutation_rate, int elitism_pct,
                  const Node robot_starts[], const Survivor survivors[],
-                 int survivor_count, const Config *cfg) {
-    if (!pop || pop_size <= 0 || robot_count <= 0 || !cfg) return;
+                 int survivor_count, const Config *cfg, Rng *rng) {
+    if (!pop || pop_size <= 0 || robot_count <= 0 || !cfg || !rng) return;
     
     // Calculate number of elite individuals to preserve
     int elite_count = (pop_size * elitism_pct) / 100;
     if (elite_count < 1) elite_count = 1;
     if (elite_count >= pop_size) elite_count = pop_size - 1;
     
-    Chromosome *new_pop = allocate_population(pop_size, robot_count, cfg->max_survivors_per_robot);
-    Chromosome *parents = allocate_population(pop_size, robot_count, cfg->max_survivors_per_robot);
+    int child_count = pop_size - elite_count;
+    
+    // Pipelined: generation g+1 is bred from the parents of generation g
+    // while the pool scores g, in a third buffer
+    int pipelined = cfg->ga_engine == GA_ENGINE_PIPELINED;
+    
+    // Breeding threads: configured count, or one per CPU we may run on
+    int breed_threads = cfg->breed_threads > 0 ? cfg->breed_threads : cpuset_available();
+    if (breed_threads > child_count) breed_threads = child_count;
     
-    if (!new_pop || !parents) {
+    // TIME_BUDGET_MS also covers backend startup and the first evaluation
+    StopCriteria stop;
+    stop_criteria_init(&stop, cfg);
+    
+    // With a process pool both generation buffers live in its shared memory,
+    // so breeding writes the genes where the workers read them and nothing
+    // is serialized per generation. Otherwise pop itself is the first buffer.
+    fitness_backend_start(pop_size, robot_count, cfg, robot_starts, survivors, survivor_count);
+    Chromosome *resident = shared_population_alloc(pop_size, robot_count, cfg->max_survivors_per_robot);
+    Chromosome *new_pop = shared_population_alloc(pop_size, robot_count, cfg->max_survivors_per_robot);
+    if (!new_pop) {
+        new_pop = allocate_population(pop_size, robot_count, cfg->max_survivors_per_robot);
+    }
+    Chromosome *third_pop = NULL;
+    if (pipelined) {
+        third_pop = shared_population_alloc(pop_size, robot_count, cfg->max_survivors_per_robot);
+        if (!third_pop) third_pop = allocate_population(pop_size, robot_count, cfg->max_survivors_per_robot);
+    }
+    if (pop[0].tour) {
+        if (resident && tour_attach(resident, pop_size, pop[0].tour_length) != 0) {
+            free_population(resident, pop_size, robot_count);
+            resident = NULL;
+        }
+        if (new_pop && tour_attach(new_pop, pop_size, pop[0].tour_length) != 0) {
+            free_population(new_pop, pop_size, robot_count);
+            new_pop = NULL;
+        }
+        if (third_pop && tour_attach(third_pop, pop_size, pop[0].tour_length) != 0) {
+            free_population(third_pop, pop_size, robot_count);
+            third_pop = NULL;
+        }
+    }
+    // Parent pairs for every child of a generation: [2*k] and [2*k+1] index into pop
+    int *parent_idx = malloc(2 * child_count * sizeof(int));
+    BreedJob breed;
+    
+    if (!new_pop || (pipelined && !third_pop) || !parent_idx || breed_job_start(&breed, breed_threads, rng) != 0) {
         fprintf(stderr, "Failed to allocate memory for evolution\n");
         if (new_pop) free_population(new_pop, pop_size, robot_count);
-        if (parents) free_population(parents, pop_size, robot_count);
+        if (third_pop) free_population(third_pop, pop_size, robot_count);
+        if (resident) free_population(resident, pop_size, robot_count);
+        free(parent_idx);
         return;
     }
     
+    breed.parent_idx = parent_idx;
+    breed.pop_size = pop_size;
+    breed.elite_count = elite_count;
+    breed.robot_count = robot_count;
+    breed.survivor_count = survivor_count;
+    breed.mutation_rate = mutation_rate;
+    breed.robot_starts = robot_starts;
+    breed.survivors = survivors;
+    breed.cfg = cfg;
+    
     printf("Starting evolution for %d generations...\n", generations);
-    printf("Elite count: %d, Mutation rate: %.2f\n", elite_count, mutation_rate);
+    printf("Elite count: %d, Mutation rate: %.2f, Breeding threads: %d\n",
+           elite_count, mutation_rate, thread_pool_size(breed.pool));
+    if (pipelined) {
+        printf("Pipelined: each generation is bred while the previous one is scored\n");
+    }
+    
+    // The generation buffers swap roles instead of being copied back
+    Chromosome *cur = pop;
+    Chromosome *next = new_pop;
+    Chromosome *spare = third_pop;
+    if (resident) {
+        for (int i = 0; i < pop_size; i++) {
+            copy_chromosome(&resident[i], &pop[i], robot_count, cfg->max_survivors_per_robot);
+        }
+        cur = resident;
+    }
     
     extern void compute_fitness_parallel_mp(Chromosome[], int, int, const Config *,
                                              const Node[], const Survivor[], int);
-    compute_fitness_parallel_mp(pop, pop_size, robot_count, cfg, 
+    compute_fitness_parallel_mp(cur, pop_size, robot_count, cfg, 
                                 robot_starts, survivors, survivor_count);
-    sort_by_fitness(pop, pop_size);
+    sort_by_fitness(cur, pop_size);
+    long total_refined = fitness_refine_top(cur, pop_size, cfg->exact_top_k, elite_count, robot_count, cfg);
+    
+    // Cost table is built before the breeding threads first touch it
+    if ((cfg->local_search != LOCAL_SEARCH_OFF || cur[0].tour) &&
+        cost_table_init(&cur[0], robot_count, survivor_count, cfg) != 0) {
+        fprintf(stderr, "Visit cost table unavailable: local search and tour split disabled\n");
+    }
     
-    double best_fitness = pop[0].fitness;
+    double best_fitness = cur[0].fitness;
     printf("Generation 0: Best fitness = %.2f\n", best_fitness);
+    ga_publish_best(&cur[0], 0);
+    
+    stop_criteria_check(&stop, cur, pop_size, robot_count, 0);
+    
+    long total_skipped = 0;
+    long total_considered = 0;
+    double breed_seconds = 0.0;
+    double wait_seconds = 0.0;
+    
+    // Generation 1 is bred up front; each loop pass then breeds one ahead
+    if (pipelined && generations > 0) {
+        breed.pop = cur;
+        breed.new_pop = next;
+        breed_job_run(&breed);
+        // Elite slots are filled when the batch lands
+        for (int i = 0; i < elite_count; i++) next[i].fitness_valid = 1;
+        fitness_batch_begin(next, pop_size, robot_count, cfg, robot_starts, survivors, survivor_count);
+    }
     
     // Evolution loop
     for (int gen = 1; gen <= generations; gen++) {
-        // Preserve elite individuals
-        for (int i = 0; i < elite_count; i++) {
-            // Deep copy elite chromosome
-            for (int r = 0; r < robot_count; r++) {
-                RobotMission *new_mission = &new_pop[i].missions[r];
-                const RobotMission *old_mission = &pop[i].missions[r];
-                
-                new_mission->robot_pos = old_mission->robot_pos;
-                new_mission->survivor_count = old_mission->survivor_count;
-                
-                for (int s = 0; s < cfg->max_survivors_per_robot; s++) {
-                    new_mission->survivor_sequence[s] = old_mission->survivor_sequence[s];
-                }
+        if (pipelined) {
+            // Breed generation gen + 1 from the parents of gen while the pool scores gen
+            if (gen < generations) {
+                double started = monotonic_seconds();
+                breed.pop = cur;
+                breed.new_pop = spare;
+                breed_job_run(&breed);
+                breed_seconds += monotonic_seconds() - started;
             }
-            new_pop[i].fitness = pop[i].fitness;
-        }
-        
-        // Generate rest of population through selection, crossover, and mutation
-        for (int i = elite_count; i < pop_size; i++) {
-            // Tournament selection to choose parents
-            tournament_select(pop, pop_size, parents, 2, robot_count);
+            double started = monotonic_seconds();
+            fitness_batch_finish();
+            wait_seconds += monotonic_seconds() - started;
+            preserve_elites(next, cur, elite_count, robot_count, cfg);
+        } else {
+            // Preserve elite individuals
+            preserve_elites(next, cur, elite_count, robot_count, cfg);
             
-            // Crossover to create child 
-            crossover(&new_pop[i], &parents[0], &parents[1], robot_count, survivor_count, cfg->max_survivors_per_robot);
+            // Generate rest of population through selection, crossover and mutation
+            breed.pop = cur;
+            breed.new_pop = next;
+            breed_job_run(&breed);
             
-            // Mutate child
-            mutate(&new_pop[i], robot_count, mutation_rate, 
-                   robot_starts, survivors, survivor_count, cfg);
+            // Compute fitness for new generation using multiprocessing
+            extern void compute_fitness_parallel_mp(Chromosome[], int, int, const Config *,
+                                                     const Node[], const Survivor[], int);
+            compute_fitness_parallel_mp(next, pop_size, robot_count, cfg,
+                                        robot_starts, survivors, survivor_count);
         }
         
-        // Compute fitness for new generation using multiprocessing
-        extern void compute_fitness_parallel_mp(Chromosome[], int, int, const Config *,
-                                                 const Node[], const Survivor[], int);
-        compute_fitness_parallel_mp(new_pop, pop_size, robot_count, cfg,
-                                    robot_starts, survivors, survivor_count);
+        FitnessCacheStats cache_stats = fitness_cache_last_stats();
+        total_skipped += cache_stats.reused + cache_stats.cache_hits;
+        total_considered += cache_stats.total;
         
-        // Sort by fitness
-        sort_by_fitness(new_pop, pop_size);
+        // Sort by fitness, then re-rank the leaders on exact path lengths
+        sort_by_fitness(next, pop_size);
+        total_refined += fitness_refine_top(next, pop_size, cfg->exact_top_k, elite_count, robot_count, cfg);
         
-        // Replace old population with new population
-        for (int i = 0; i < pop_size; i++) {
-            for (int r = 0; r < robot_count; r++) {
-                RobotMission *pop_mission = &pop[i].missions[r];
-                const RobotMission *new_mission = &new_pop[i].missions[r];
-                
-                // Copy non-pointer fields
-                pop_mission->robot_pos = new_mission->robot_pos;
-                pop_mission->survivor_count = new_mission->survivor_count;
-                
-                for (int s = 0; s < cfg->max_survivors_per_robot; s++) {
-                    pop_mission->survivor_sequence[s] = new_mission->survivor_sequence[s];
-                }
-            }
-            pop[i].fitness = new_pop[i].fitness;
+        // New generation becomes the current one; pipelined, the generation
+        // bred during this pass is next and the old parents are bred into
+        Chromosome *temp = cur;
+        cur = next;
+        if (pipelined) {
+            next = spare;
+            spare = temp;
+        } else {
+            next = temp;
         }
         
         // Report progress 
-        double current_best = pop[0].fitness;
+        double current_best = cur[0].fitness;
         double improvement = current_best - best_fitness;
         if (gen % 25 == 0 || (improvement > 5.0 && current_best > best_fitness)) {
             printf("Generation %d: Best fitness = %.2f", gen, current_best);
             if (improvement > 0.01) {
                 printf(" (improvement: %.2f)", improvement);
             }
+            printf(" [cache: %d reused, %d hits, %d evaluated]",
+                   cache_stats.reused, cache_stats.cache_hits, cache_stats.evaluated);
             printf("\n");
             best_fitness = current_best;
         }
+        
+        ga_publish_best(&cur[0], gen);
+        const char *stop_reason = stop_criteria_check(&stop, cur, pop_size, robot_count, gen);
+        if (stop_reason) {
+            printf("Stopping at generation %d: %s (best = %.2f)\n", gen, stop_reason, current_best);
+            break;
+        }
+        
+        if (pipelined && gen < generations) {
+            for (int i = 0; i < elite_count; i++) next[i].fitness_valid = 1;
+            fitness_batch_begin(next, pop_size, robot_count, cfg, robot_starts, survivors, survivor_count);
+        }
+    }
+    stop_criteria_free(&stop);
+    
+    breed_job_stop(&breed);
+    
+    // Leave the final generation in the caller's buffer
+    if (cur != pop) {
+        for (int i = 0; i < pop_size; i++) {
+            copy_chromosome(&pop[i], &cur[i], robot_count, cfg->max_survivors_per_robot);
+        }
     }
     
     printf("Evolution complete. Final best fitness = %.2f\n", pop[0].fitness);
+    if (total_considered > 0) {
+        printf("Fitness cache: skipped %ld of %ld evaluations (%.1f%%)\n",
+               total_skipped, total_considered, 100.0 * total_skipped / total_considered);
+    }
+    if (total_refined > 0) {
+        printf("Exact path rescoring: %ld chromosomes\n", total_refined);
+    }
+    if (pipelined) {
+        printf("Pipeline: %.2f s breeding behind evaluation, %.2f s waiting for it\n",
+               breed_seconds, wait_seconds);
+    }
     
     // Cleanup
     free_population(new_pop, pop_size, robot_count);
-    free_population(parents, pop_size, robot_count);
+    if (third_pop) free_population(third_pop, pop_size, robot_count);
+    if (resident) free_population(resident, pop_size, robot_count);
+    free(parent_idx);
 }
\ No newline at end of file
@@ -3,17 +3,10 @@
 // Forward declarations
 void cleanup_shared_memory(void);
 void shutdown_process_pool(void);
+static void free_population_arena(void);
 
-// SIGCHLD handler to reap zombie
-static void sigchld_handler(int sig) {
-    (void)sig;
-    pid_t pid;
-    int status;
-    // Reap all zombie children (use WNOHANG to avoid blocking)
-    while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
-   
-    }
-}
+// In-process backend (EVAL_BACKEND = thread)
+static ThreadPool *eval_threads = NULL;
 
 static void atexit_cleanup(void) {
     shutdown_process_pool();
@@ -21,15 +14,15 @@ static void atexit_cleanup(void) {
 
 static void signal_handler(int sig) {
     (void)sig;
-    sigchld_handler(sig);
+    // Joining threads is not safe here and _exit ends them anyway
+    eval_threads = NULL;
     shutdown_process_pool();
     _exit(1);
 }
 
-// Register signal handlers for cleanup
+// Register signal handlers for cleanup. Workers are not reaped on SIGCHLD:
+// the pool waits for them itself so a crash is noticed and recovered.
 static void register_signal_handlers(void) {
-    // Install SIGCHLD handler to reap zombies immediately
-    signal(SIGCHLD, sigchld_handler);
     signal(SIGINT, signal_handler);    // Ctrl+C
     signal(SIGTERM, signal_handler);   // Termination request
     signal(SIGSEGV, signal_handler);   // Segmentation fault
@@ -38,15 +31,41 @@ static void register_signal_handlers(void) {
     atexit(atexit_cleanup);            // Normal exit
 }
 
+// Workers forked after register_signal_handlers must not run the master's cleanup
+static void reset_signal_handlers(void) {
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    signal(SIGSEGV, SIG_DFL);
+    signal(SIGABRT, SIG_DFL);
+    signal(SIGTSTP, SIG_DFL);
+}
+
+// Lease on the chunk a worker is evaluating. A worker that dies holding one
+// is replaced and its successor re-runs the chunk before claiming new work.
+typedef struct {
+    int begin;                // leased slots [begin, end), end == begin = none
+    int end;
+    long long started_ns;     // when the chunk was claimed, for stall detection
+    unsigned int epoch;       // batch the lease belongs to
+    unsigned int done_epoch;  // last batch the worker finished its share of
+    int retries;              // replacements that tried this chunk already
+} __attribute__((aligned(64))) WorkerLease;
+
 // Shared memory structure
 typedef struct {
-    int pop_size;
+    int pop_size;         // chromosomes in the current batch
+    int capacity;         // chromosome slots in the shared arrays, fixed at init
     int robot_count;
     int survivor_count;
     int num_workers;
-    int next_chromosome;  
+    int active_workers;   // workers with a smaller id take part, the others exit
+    int next_chromosome;  // first unclaimed slot, advanced by chunk_size with fetch_add
+    int chunk_size;       // slots claimed at a time in the current batch
     int shutdown_flag;   
-    int work_ready;       
+    unsigned int work_epoch;  // futex word, bumped once per batch
+    int workers_done;         // futex word, workers out of the batch; a wake-up hint, leases decide
+    long long busy_ns;        // evaluation time summed over workers for the batch
+    Chromosome *batch_pop;    // resident batch: evaluate batch_pop[batch_indices[slot]], NULL = staged slots
     int max_survivors_per_robot;  
     size_t shm_data_size; 
     size_t shm_chromosomes_size;  
@@ -54,31 +73,53 @@ typedef struct {
     Config config;
     Node *robot_starts;  
     Survivor *survivors; 
+    WorkerLease *leases;      // one per worker id
 } SharedData;
 
 typedef struct {
+    MissionScore *mission_scores;  // cached per-mission fitness terms, updated by workers
     RobotMission *missions; 
     int *survivor_sequences; 
     int *survivor_counts;  
     Node *robot_positions; 
 } SharedChromosomes;
 
-#define SHM_NAME "/ga_shared_mem"
-#define SHM_CHROMOSOMES_NAME "/ga_chromosomes_mem"
-#define SEM_WORK_NAME "/ga_work_sem"
-#define SEM_RESULT_NAME "/ga_result_sem"
-#define SEM_MUTEX_NAME "/ga_mutex_sem"
+// Chunks aim at this much work so a claim costs next to nothing
+#define CHUNK_TARGET_SECONDS 50e-6
+// An automatic pool keeps only workers with at least this much work per batch
+#define MIN_WORKER_SECONDS 200e-6
+// Evaluations this much slower than the fastest seen mean workers share cores
+#define CONTENDED_SLOWDOWN 1.5
+// How often the master checks on workers while a batch runs
+#define LEASE_POLL_SECONDS 0.05
+// A lease held longer than this plus LEASE_SLACK times its expected time is stalled
+#define LEASE_MIN_SECONDS 30.0
+#define LEASE_SLACK 100.0
+// Replacements that may crash on the same chunk before the master runs it itself
+#define LEASE_MAX_RETRIES 2
+// How long shutdown waits for workers to leave on their own before killing them
+#define SHUTDOWN_GRACE_SECONDS 2.0
 
 SharedData *shared_data = NULL; 
 SharedChromosomes *shared_chromosomes = NULL; 
-sem_t *sem_work = NULL; 
-sem_t *sem_result = NULL; 
-sem_t *sem_mutex = NULL; 
-static int shm_fd = -1;
-static int shm_chromosomes_fd = -1;
-static pid_t *worker_pids = NULL; 
-static int num_worker_processes = 0; 
+static pid_t *worker_pids = NULL;    // one slot per worker id, 0 = not running
+static int *worker_cpus = NULL;      // CPU each worker id is pinned to, -1 = unpinned
+static int worker_capacity = 0;      // most workers the pool may run
+static int num_worker_processes = 0; // workers taking part in batches
+static int pool_auto = 0;            // POOL_SIZE = 0: resized between batches
+static double best_item_seconds = 0.0;  // fastest measured evaluation, the uncontended cost
 static int pool_initialized = 0;  
+static double item_seconds = 0.0;    // measured cost of one evaluation, 0 = unknown
+
+// Process-shared futexes on words in the MAP_SHARED segment. timeout is
+// relative, NULL waits indefinitely; -1 with ETIMEDOUT when it runs out.
+static int futex_wait(void *addr, unsigned int expected, const struct timespec *timeout) {
+    return (int)syscall(SYS_futex, addr, FUTEX_WAIT, expected, timeout, NULL, 0);
+}
+
+static void futex_wake(void *addr, int count) {
+    syscall(SYS_futex, addr, FUTEX_WAKE, count, NULL, NULL, 0);
+}
 
 int init_shared_memory(int pop_size, int robot_count, int survivor_count, int num_workers, int max_survivors_per_robot) {
    
@@ -99,35 +140,23 @@ int init_shared_memory(int pop_size, int robot_count, int survivor_count, int nu
         max_survivors_per_robot = 100;
     }
 
-    shm_fd = shm_open(SHM_NAME, O_CREAT | O_RDWR, 0666);
-    if (shm_fd == -1) {
-        perror("shm_open (main)");
-        return -1;
-    }
-    
     // Calculate total size needed
     size_t base_size = sizeof(SharedData);
     size_t fitness_size = pop_size * sizeof(double);
     size_t robot_starts_size = robot_count * sizeof(Node);
     size_t survivors_size = survivor_count * sizeof(Survivor);
-    size_t shm_size = base_size + fitness_size + robot_starts_size + survivors_size;
+    size_t leases_offset = (base_size + fitness_size + robot_starts_size + survivors_size + 63) & ~(size_t)63;
+    size_t shm_size = leases_offset + num_workers * sizeof(WorkerLease);
     
-    if (ftruncate(shm_fd, shm_size) == -1) {
-        perror("ftruncate (main)");
-        close(shm_fd);
-        shm_unlink(SHM_NAME);
-        return -1;
-    }
-    
-    shared_data = mmap(NULL, shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+    // Anonymous shared mappings have no name for another run to collide with
+    // and vanish with the last process; workers inherit them across fork()
+    shared_data = mmap(NULL, shm_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
     if (shared_data == MAP_FAILED) {
         perror("mmap (main)");
-        close(shm_fd);
-        shm_unlink(SHM_NAME);
+        shared_data = NULL;
         return -1;
     }
     
-
     memset(shared_data, 0, base_size);
     
     // Set up array pointers within shared memory
@@ -135,65 +164,53 @@ int init_shared_memory(int pop_size, int robot_count, int survivor_count, int nu
     shared_data->fitness_results = (double *)(base_ptr + base_size);
     shared_data->robot_starts = (Node *)(base_ptr + base_size + fitness_size);
     shared_data->survivors = (Survivor *)(base_ptr + base_size + fitness_size + robot_starts_size);
+    shared_data->leases = (WorkerLease *)(base_ptr + leases_offset);
     
     // Set the data fields
     shared_data->pop_size = pop_size;
+    shared_data->capacity = pop_size;
     shared_data->robot_count = robot_count;
     shared_data->survivor_count = survivor_count;
     shared_data->num_workers = num_workers;
     shared_data->max_survivors_per_robot = max_survivors_per_robot;
     shared_data->shm_data_size = shm_size;
     shared_data->next_chromosome = 0;
+    shared_data->chunk_size = 1;
     shared_data->shutdown_flag = 0;
-    shared_data->work_ready = 0;
-    
-    shm_chromosomes_fd = shm_open(SHM_CHROMOSOMES_NAME, O_CREAT | O_RDWR, 0666);
-    if (shm_chromosomes_fd == -1) {
-        perror("shm_open (chromosomes)");
-        munmap(shared_data, shm_size);
-        close(shm_fd);
-        shm_unlink(SHM_NAME);
-        return -1;
-    }
+    shared_data->work_epoch = 0;
+    shared_data->workers_done = 0;
     
     // Calculate total size needed for chromosomes
     size_t chromosomes_base_size = sizeof(SharedChromosomes);
+    size_t mission_scores_size = pop_size * robot_count * sizeof(MissionScore);
     size_t missions_size = pop_size * robot_count * sizeof(RobotMission);
     size_t survivor_sequences_size = pop_size * robot_count * max_survivors_per_robot * sizeof(int);
     size_t survivor_counts_size = pop_size * robot_count * sizeof(int);
     size_t robot_positions_size = pop_size * robot_count * sizeof(Node);
-    size_t shm_chromosomes_size = chromosomes_base_size + missions_size + survivor_sequences_size + 
+    size_t shm_chromosomes_size = chromosomes_base_size + mission_scores_size + missions_size + survivor_sequences_size + 
                                    survivor_counts_size + robot_positions_size;
     
-    if (ftruncate(shm_chromosomes_fd, shm_chromosomes_size) == -1) {
-        perror("ftruncate (chromosomes)");
-        close(shm_chromosomes_fd);
-        munmap(shared_data, shm_size);
-        close(shm_fd);
-        shm_unlink(SHM_NAME);
-        shm_unlink(SHM_CHROMOSOMES_NAME);
-        return -1;
-    }
-    
-    shared_chromosomes = mmap(NULL, shm_chromosomes_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_chromosomes_fd, 0);
+    shared_chromosomes = mmap(NULL, shm_chromosomes_size, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_ANONYMOUS, -1, 0);
     if (shared_chromosomes == MAP_FAILED) {
         perror("mmap (chromosomes)");
-        close(shm_chromosomes_fd);
+        shared_chromosomes = NULL;
         munmap(shared_data, shm_size);
-        close(shm_fd);
-        shm_unlink(SHM_NAME);
-        shm_unlink(SHM_CHROMOSOMES_NAME);
+        shared_data = NULL;
         return -1;
     }
     
     memset(shared_chromosomes, 0, chromosomes_base_size);
     
     // Set up array pointers within shared memory for chromosomes
-    char *chromosomes_base_ptr = (char *)shared_chromosomes;
-    shared_chromosomes->missions = (RobotMission *)(chromosomes_base_ptr + chromosomes_base_size);
-    shared_chromosomes->survivor_sequences = (int *)(chromosomes_base_ptr + chromosomes_base_size + missions_size);
-    shared_chromosomes->survivor_counts = (int *)(chromosomes_base_ptr + chromosomes_base_size + missions_size + survivor_sequences_size);
-    shared_chromosomes->robot_positions = (Node *)(chromosomes_base_ptr + chromosomes_base_size + missions_size + 
+    // (mission scores first so the doubles stay 8-byte aligned)
+    char *chromosomes_base_ptr = (char *)shared_chromosomes + chromosomes_base_size;
+    shared_chromosomes->mission_scores = (MissionScore *)chromosomes_base_ptr;
+    chromosomes_base_ptr += mission_scores_size;
+    shared_chromosomes->missions = (RobotMission *)(chromosomes_base_ptr);
+    shared_chromosomes->survivor_sequences = (int *)(chromosomes_base_ptr + missions_size);
+    shared_chromosomes->survivor_counts = (int *)(chromosomes_base_ptr + missions_size + survivor_sequences_size);
+    shared_chromosomes->robot_positions = (Node *)(chromosomes_base_ptr + missions_size + 
                                                     survivor_sequences_size + survivor_counts_size);
     
     // Store chromosomes size in shared_data
@@ -203,41 +220,19 @@ int init_shared_memory(int pop_size, int robot_count, int survivor_count, int nu
     memset(shared_data->fitness_results, 0, fitness_size);
     memset(shared_data->robot_starts, 0, robot_starts_size);
     memset(shared_data->survivors, 0, survivors_size);
+    memset(shared_data->leases, 0, num_workers * sizeof(WorkerLease));
+    memset(shared_chromosomes->mission_scores, 0, mission_scores_size);
     memset(shared_chromosomes->missions, 0, missions_size);
     memset(shared_chromosomes->survivor_sequences, 0, survivor_sequences_size);
     memset(shared_chromosomes->survivor_counts, 0, survivor_counts_size);
     memset(shared_chromosomes->robot_positions, 0, robot_positions_size);
     
-    sem_work = sem_open(SEM_WORK_NAME, O_CREAT | O_RDWR, 0666, 0);
-    sem_result = sem_open(SEM_RESULT_NAME, O_CREAT | O_RDWR, 0666, 0);
-    sem_mutex = sem_open(SEM_MUTEX_NAME, O_CREAT | O_RDWR, 0666, 1);
-    
-    if (sem_work == SEM_FAILED || sem_result == SEM_FAILED || sem_mutex == SEM_FAILED) {
-        perror("sem_open");
-        cleanup_shared_memory();
-        return -1;
-    }
-    
     return 0;
 }
 
 
 void cleanup_shared_memory(void) {
-    if (sem_work != NULL && sem_work != SEM_FAILED) {
-        sem_close(sem_work);
-        sem_unlink(SEM_WORK_NAME);
-        sem_work = NULL;
-    }
-    if (sem_result != NULL && sem_result != SEM_FAILED) {
-        sem_close(sem_result);
-        sem_unlink(SEM_RESULT_NAME);
-        sem_result = NULL;
-    }
-    if (sem_mutex != NULL && sem_mutex != SEM_FAILED) {
-        sem_close(sem_mutex);
-        sem_unlink(SEM_MUTEX_NAME);
-        sem_mutex = NULL;
-    }
+    free_population_arena();
     
     if (shared_chromosomes != NULL && shared_chromosomes != MAP_FAILED) {
         size_t chromosomes_size = (shared_data && shared_data->shm_chromosomes_size > 0) ? 
@@ -245,304 +240,369 @@ void cleanup_shared_memory(void) {
         munmap(shared_chromosomes, chromosomes_size);
         shared_chromosomes = NULL;
     }
-    if (shm_chromosomes_fd != -1) {
-        close(shm_chromosomes_fd);
-        shm_unlink(SHM_CHROMOSOMES_NAME);
-        shm_chromosomes_fd = -1;
-    }
     
     if (shared_data != NULL && shared_data != MAP_FAILED) {
         size_t data_size = shared_data->shm_data_size > 0 ? shared_data->shm_data_size : sizeof(SharedData);
         munmap(shared_data, data_size);
         shared_data = NULL;
     }
-    if (shm_fd != -1) {
-        close(shm_fd);
-        shm_unlink(SHM_NAME);
-        shm_fd = -1;
+}
+
+// Generation buffers resident in an anonymous MAP_SHARED mapping made before
+// the fork. Pointers into it are the same in every process, so workers read
+// the chromosomes breeding wrote and store fitness and scores in place.
+// The pipelined engine keeps a third generation in flight.
+#define ARENA_MAX_BUFFERS 3
+#define ARENA_ALIGN(n) (((n) + 63) & ~(size_t)63)
+
+static char *arena = NULL;
+static size_t arena_size = 0;
+static Chromosome *arena_buffers[ARENA_MAX_BUFFERS];
+static int arena_in_use[ARENA_MAX_BUFFERS];
+static int arena_buffer_count = 0;
+static int arena_pop_size = 0;
+static int arena_robot_count = 0;
+static int arena_max_surv = 0;
+static int *batch_indices = NULL;    // in the arena, indices of a resident batch
+
+static int init_population_arena(int pop_size, int robot_count, int max_surv, int buffers) {
+    size_t chromosomes_size = ARENA_ALIGN(pop_size * sizeof(Chromosome));
+    size_t missions_size = ARENA_ALIGN((size_t)pop_size * robot_count * sizeof(RobotMission));
+    size_t scores_size = ARENA_ALIGN((size_t)pop_size * robot_count * sizeof(MissionScore));
+    size_t sequences_size = ARENA_ALIGN((size_t)pop_size * robot_count * max_surv * sizeof(int));
+    size_t buffer_size = chromosomes_size + missions_size + scores_size + sequences_size;
+    size_t indices_size = ARENA_ALIGN(pop_size * sizeof(int));
+    
+    arena_buffer_count = buffers < ARENA_MAX_BUFFERS ? buffers : ARENA_MAX_BUFFERS;
+    arena_size = indices_size + arena_buffer_count * buffer_size;
+    arena = mmap(NULL, arena_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (arena == MAP_FAILED) {
+        perror("mmap (population arena)");
+        arena = NULL;
+        arena_size = 0;
+        arena_buffer_count = 0;
+        return -1;
     }
     
-    if (sem_work != NULL && sem_work != SEM_FAILED) {
-        sem_close(sem_work);
-        sem_unlink(SEM_WORK_NAME);
-        sem_work = NULL;
+    batch_indices = (int *)arena;
+    for (int b = 0; b < arena_buffer_count; b++) {
+        char *base = arena + indices_size + b * buffer_size;
+        Chromosome *pop = (Chromosome *)base;
+        RobotMission *missions = (RobotMission *)(base + chromosomes_size);
+        MissionScore *scores = (MissionScore *)(base + chromosomes_size + missions_size);
+        int *sequences = (int *)(base + chromosomes_size + missions_size + scores_size);
+        
+        // Genes are wired once; shared_population_alloc only resets the contents
+        for (int i = 0; i < pop_size; i++) {
+            pop[i].missions = &missions[(size_t)i * robot_count];
+            pop[i].scores = &scores[(size_t)i * robot_count];
+            for (int r = 0; r < robot_count; r++) {
+                pop[i].missions[r].survivor_sequence = &sequences[((size_t)i * robot_count + r) * max_surv];
+            }
+        }
+        arena_buffers[b] = pop;
+        arena_in_use[b] = 0;
     }
-    if (sem_result != NULL && sem_result != SEM_FAILED) {
-        sem_close(sem_result);
-        sem_unlink(SEM_RESULT_NAME);
-        sem_result = NULL;
+    arena_pop_size = pop_size;
+    arena_robot_count = robot_count;
+    arena_max_surv = max_surv;
+    return 0;
+}
+
+static void free_population_arena(void) {
+    if (!arena) return;
+    // Buffers an engine still holds stay mapped until exit
+    for (int b = 0; b < arena_buffer_count; b++) {
+        if (arena_in_use[b]) return;
     }
-    if (sem_mutex != NULL && sem_mutex != SEM_FAILED) {
-        sem_close(sem_mutex);
-        sem_unlink(SEM_MUTEX_NAME);
-        sem_mutex = NULL;
+    munmap(arena, arena_size);
+    arena = NULL;
+    arena_size = 0;
+    arena_buffer_count = 0;
+    batch_indices = NULL;
+}
+
+static int shared_population_index(const Chromosome *pop) {
+    if (!arena) return -1;
+    for (int b = 0; b < arena_buffer_count; b++) {
+        if (arena_in_use[b] && arena_buffers[b] == pop) return b;
     }
+    return -1;
 }
 
-void copy_population_to_shared(Chromosome pop[], int pop_size, int robot_count,
-                               const Node robot_starts[], const Survivor survivors[]) {
-    if (!shared_data || !shared_chromosomes) return;
+Chromosome *shared_population_alloc(int pop_size, int robot_count, int max_survivors_per_robot) {
+    if (!arena || pop_size > arena_pop_size || robot_count != arena_robot_count ||
+        max_survivors_per_robot != arena_max_surv) {
+        return NULL;
+    }
+    for (int b = 0; b < arena_buffer_count; b++) {
+        if (arena_in_use[b]) continue;
+        
+        Chromosome *pop = arena_buffers[b];
+        for (int i = 0; i < pop_size; i++) {
+            pop[i].tour = NULL;
+            pop[i].tour_length = 0;
+            pop[i].fidelity = FIDELITY_ESTIMATE;
+            pop[i].fitness = 0.0;
+            pop[i].fitness_valid = 0;
+            for (int r = 0; r < robot_count; r++) {
+                pop[i].scores[r] = (MissionScore){0.0, 0.0, 0, 1};  // Not scored yet
+                pop[i].missions[r].robot_pos = (Node){0, 0, 0};
+                pop[i].missions[r].survivor_count = 0;
+            }
+        }
+        arena_in_use[b] = 1;
+        return pop;
+    }
+    return NULL;
+}
+
+int shared_population_release(Chromosome *pop, int pop_size) {
+    int b = shared_population_index(pop);
+    if (b < 0) return 0;
     
-    // Copy configuration data
-    memcpy(shared_data->robot_starts, robot_starts, robot_count * sizeof(Node));
-    memcpy(shared_data->survivors, survivors, shared_data->survivor_count * sizeof(Survivor));
+    // Giant tours are private to the master and come from the heap
+    for (int i = 0; i < pop_size; i++) {
+        free(pop[i].tour);
+        pop[i].tour = NULL;
+    }
+    arena_in_use[b] = 0;
+    return 1;
+}
+
+// Copy the chromosomes listed in indices[] into shared slots 0..count-1
+void copy_population_to_shared(Chromosome pop[], const int indices[], int count, int robot_count) {
+    if (!shared_data || !shared_chromosomes) return;
     
     // Copy chromosome data
     int max_surv = shared_data->max_survivors_per_robot;
-    for (int i = 0; i < pop_size; i++) {
+    for (int slot = 0; slot < count; slot++) {
+        const Chromosome *c = &pop[indices[slot]];
         for (int r = 0; r < robot_count; r++) {
-            int idx = i * robot_count + r;
-            shared_chromosomes->robot_positions[idx] = pop[i].missions[r].robot_pos;
-            shared_chromosomes->survivor_counts[idx] = pop[i].missions[r].survivor_count;
+            int idx = slot * robot_count + r;
+            shared_chromosomes->robot_positions[idx] = c->missions[r].robot_pos;
+            shared_chromosomes->survivor_counts[idx] = c->missions[r].survivor_count;
+            shared_chromosomes->mission_scores[idx] = c->scores[r];
             
             // Copy survivor sequence
-            int seq_base = i * robot_count * max_surv + r * max_surv;
-            int actual_count = pop[i].missions[r].survivor_count;
+            int seq_base = slot * robot_count * max_surv + r * max_surv;
+            int actual_count = c->missions[r].survivor_count;
             if (actual_count > max_surv) actual_count = max_surv;
             for (int s = 0; s < actual_count; s++) {
-                shared_chromosomes->survivor_sequences[seq_base + s] = pop[i].missions[r].survivor_sequence[s];
+                shared_chromosomes->survivor_sequences[seq_base + s] = c->missions[r].survivor_sequence[s];
             }
         }
     }
-    
-    shared_data->next_chromosome = 0;
 }
 
-void copy_fitness_from_shared(Chromosome pop[], int pop_size) {
-    if (!shared_data) return;
+void copy_fitness_from_shared(Chromosome pop[], const int indices[], int count, int robot_count) {
+    if (!shared_data || !shared_chromosomes) return;
     
-    for (int i = 0; i < pop_size; i++) {
-        pop[i].fitness = shared_data->fitness_results[i];
+    for (int slot = 0; slot < count; slot++) {
+        Chromosome *c = &pop[indices[slot]];
+        c->fitness = shared_data->fitness_results[slot];
+        // Bring back mission scores the workers refreshed
+        memcpy(c->scores, &shared_chromosomes->mission_scores[slot * robot_count],
+               robot_count * sizeof(MissionScore));
     }
 }
 
-void worker_process(void) {
-    int shm_fd = shm_open(SHM_NAME, O_RDWR, 0666);
-    if (shm_fd == -1) {
-        perror("worker: shm_open");
-        exit(1);
-    }
-    
-    SharedData *temp_shared = mmap(NULL, sizeof(SharedData), PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
-    if (temp_shared == MAP_FAILED) {
-        perror("worker: mmap (temp)");
-        close(shm_fd);
-        exit(1);
-    }
-    
-    // Get the actual size
-    size_t shm_data_size = temp_shared->shm_data_size;
-    if (shm_data_size == 0 || shm_data_size < sizeof(SharedData)) {
-        // Fallback: use a reasonable default size
-        shm_data_size = sizeof(SharedData) + 1000 * sizeof(double) + 100 * sizeof(Node) + 10000 * sizeof(Survivor);
-    }
-    munmap(temp_shared, sizeof(SharedData));
-    
-    SharedData *local_shared = mmap(NULL, shm_data_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
-    if (local_shared == MAP_FAILED) {
-        perror("worker: mmap");
-        close(shm_fd);
-        exit(1);
-    }
-    
-    // Calculate array pointers locally
-    int pop_size_val = local_shared->pop_size > 0 ? local_shared->pop_size : 1000;
-    int robot_count_val = local_shared->robot_count > 0 ? local_shared->robot_count : 100;
-    size_t base_size = sizeof(SharedData);
-    char *base_ptr = (char *)local_shared;
-    if (!base_ptr) {
-        fprintf(stderr, "Worker: Invalid base pointer\n");
-        exit(1);
-    }
-    
-    double *local_fitness_results = (double *)(base_ptr + base_size);
-    size_t fitness_size = pop_size_val * sizeof(double);
-    size_t robot_starts_size = robot_count_val * sizeof(Node);
-    Survivor *local_survivors = (Survivor *)(base_ptr + base_size + fitness_size + robot_starts_size);
-    
-    if ((char *)local_fitness_results >= (char *)local_shared + shm_data_size ||
-        (char *)local_survivors >= (char *)local_shared + shm_data_size) {
-        fprintf(stderr, "Worker: Calculated pointers out of bounds\n");
-        exit(1);
-    }
-    
-    int shm_chromosomes_fd = shm_open(SHM_CHROMOSOMES_NAME, O_RDWR, 0666);
-    if (shm_chromosomes_fd == -1) {
-        perror("worker: shm_open chromosomes");
-        exit(1);
-    }
-    
-    // Get chromosomes size from shared data
-    size_t shm_chromosomes_size = local_shared->shm_chromosomes_size;
-    if (shm_chromosomes_size == 0) {
-        int pop_size = local_shared->pop_size > 0 ? local_shared->pop_size : 1000;
-        int robot_count = local_shared->robot_count > 0 ? local_shared->robot_count : 100;
-        int max_surv = local_shared->max_survivors_per_robot > 0 ? local_shared->max_survivors_per_robot : 100;
-        size_t chromosomes_base_size = sizeof(SharedChromosomes);
-        size_t missions_size = pop_size * robot_count * sizeof(RobotMission);
-        size_t survivor_sequences_size = pop_size * robot_count * max_surv * sizeof(int);
-        size_t survivor_counts_size = pop_size * robot_count * sizeof(int);
-        size_t robot_positions_size = pop_size * robot_count * sizeof(Node);
-        shm_chromosomes_size = chromosomes_base_size + missions_size + survivor_sequences_size + 
-                               survivor_counts_size + robot_positions_size;
-    }
-    
-    SharedChromosomes *local_chromosomes = mmap(NULL, shm_chromosomes_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_chromosomes_fd, 0);
-    if (local_chromosomes == MAP_FAILED) {
-        perror("worker: mmap chromosomes");
-        close(shm_chromosomes_fd);
-        exit(1);
-    }
-    
-    // Calculate array pointers locally for chromosomes
-    size_t chromosomes_base_size = sizeof(SharedChromosomes);
-    char *chromosomes_base_ptr = (char *)local_chromosomes;
-    int pop_size = local_shared->pop_size > 0 ? local_shared->pop_size : 1000;
-    int robot_count = local_shared->robot_count > 0 ? local_shared->robot_count : 100;
-    int max_surv = local_shared->max_survivors_per_robot > 0 ? local_shared->max_survivors_per_robot : 100;
-    
-    // Calculate local pointers
-    size_t missions_size = pop_size * robot_count * sizeof(RobotMission);
-    size_t survivor_sequences_size = pop_size * robot_count * max_surv * sizeof(int);
-    size_t survivor_counts_size = pop_size * robot_count * sizeof(int);
-    
-    int *local_survivor_sequences = (int *)(chromosomes_base_ptr + chromosomes_base_size + missions_size);
-    int *local_survivor_counts = (int *)(chromosomes_base_ptr + chromosomes_base_size + missions_size + survivor_sequences_size);
-    Node *local_robot_positions = (Node *)(chromosomes_base_ptr + chromosomes_base_size + missions_size + 
-                                           survivor_sequences_size + survivor_counts_size);
-    
-    sem_t *sem_work_local = sem_open(SEM_WORK_NAME, 0);
-    sem_t *sem_result_local = sem_open(SEM_RESULT_NAME, 0);
-    sem_t *sem_mutex_local = sem_open(SEM_MUTEX_NAME, 0);
+// A worker's view of the shared batch arrays
+typedef struct {
+    SharedData *shared;
+    double *fitness_results;
+    MissionScore *mission_scores;
+    int *survivor_sequences;
+    int *survivor_counts;
+    Node *robot_positions;
+} WorkerView;
+
+// Score the chromosome in slot where it lies in shared memory. Clean
+// missions reuse the cached scores, dirty ones are rescored in place so the
+// master picks them up with the fitness. The building grid was allocated
+// before the fork, so it is inherited.
+static void evaluate_shared_slot(const WorkerView *view, int slot) {
+    const SharedData *shared = view->shared;
+    int robot_count = shared->robot_count;
+    int max_surv = shared->max_survivors_per_robot > 0 ? shared->max_survivors_per_robot : 100;
+    size_t first = (size_t)slot * robot_count;
     
-    if (sem_work_local == SEM_FAILED || sem_result_local == SEM_FAILED || sem_mutex_local == SEM_FAILED) {
-        perror("worker: sem_open");
-        exit(1);
+    ChromosomeView genes = {
+        &view->robot_positions[first],
+        &view->survivor_counts[first],
+        &view->survivor_sequences[first * max_surv],
+        max_surv
+    };
+    view->fitness_results[slot] = fitness_view_cached(&genes, &view->mission_scores[first],
+                                                      robot_count, &shared->config);
+}
+
+static WorkerView worker_view(void) {
+    WorkerView view = {shared_data, shared_data->fitness_results, shared_chromosomes->mission_scores,
+                       shared_chromosomes->survivor_sequences, shared_chromosomes->survivor_counts,
+                       shared_chromosomes->robot_positions};
+    return view;
+}
+
+static void evaluate_slots(const WorkerView *view, int begin, int end) {
+    const SharedData *shared = view->shared;
+    Chromosome *resident = shared->batch_pop;
+    for (int slot = begin; slot < end; slot++) {
+        if (resident) {
+            Chromosome *c = &resident[batch_indices[slot]];
+            c->fitness = fitness_chromosome_cached(c, shared->robot_count, &shared->config);
+        } else {
+            evaluate_shared_slot(view, slot);
+        }
     }
+}
+
+// One worker's part of batch epoch: the chunk a dead predecessor leased,
+// if any, then chunks claimed until the batch runs out. Each claim is
+// leased first so a crash in the middle of it loses nothing.
+static void run_batch_share(const WorkerView *view, WorkerLease *lease, unsigned int epoch) {
+    SharedData *shared = view->shared;
+    int count = shared->pop_size;
+    int chunk = shared->chunk_size > 0 ? shared->chunk_size : 1;
     
-    while (1) {
-        if (local_shared->shutdown_flag) {
-            break;
-        }
-        
-        // Wait for work
-        if (sem_wait(sem_work_local) != 0) {
-            perror("worker: sem_wait (work)");
-            break;
+    int begin = lease->begin;
+    int end = lease->epoch == epoch ? lease->end : begin;
+    lease->epoch = epoch;
+    for (;;) {
+        if (__atomic_load_n(&shared->shutdown_flag, __ATOMIC_RELAXED)) break;
+        if (end <= begin) {
+            begin = __atomic_fetch_add(&shared->next_chromosome, chunk, __ATOMIC_RELAXED);
+            if (begin >= count) break;
+            end = begin + chunk < count ? begin + chunk : count;
         }
         
-        if (local_shared->shutdown_flag) {
-            sem_post(sem_result_local); 
-            break;
-        }
+        double started = monotonic_seconds();
+        lease->started_ns = (long long)(started * 1e9);
+        lease->begin = begin;
+        __atomic_store_n(&lease->end, end, __ATOMIC_RELEASE);
         
-        // Get next chromosome index
-        if (sem_wait(sem_mutex_local) != 0) {
-            perror("worker: sem_wait (mutex)");
-            sem_post(sem_result_local);
-            break;
-        }
-        int chrom_idx = local_shared->next_chromosome++;
-        int pop_size = local_shared->pop_size;
-        sem_post(sem_mutex_local);
+        evaluate_slots(view, begin, end);
         
-        if (chrom_idx >= pop_size) {
-            sem_post(sem_result_local);
-            continue;
+        long long spent = (long long)((monotonic_seconds() - started) * 1e9);
+        __atomic_add_fetch(&shared->busy_ns, spent, __ATOMIC_RELAXED);
+        __atomic_store_n(&lease->end, begin, __ATOMIC_RELEASE);
+        lease->retries = 0;
+        end = begin;
+    }
+    __atomic_store_n(&lease->done_epoch, epoch, __ATOMIC_RELEASE);
+}
+
+// Runs in a forked child; the shared segments are inherited at the same addresses.
+// seen is the batch epoch at the fork, so only later batches count as work.
+void worker_process(int id, unsigned int seen) {
+    SharedData *local_shared = shared_data;
+    WorkerView view = worker_view();
+    WorkerLease *lease = &local_shared->leases[id];
+    
+    while (1) {
+        unsigned int epoch;
+        while ((epoch = __atomic_load_n(&local_shared->work_epoch, __ATOMIC_ACQUIRE)) == seen) {
+            futex_wait(&local_shared->work_epoch, seen, NULL);
         }
-        
-        // Validate bounds
-        if (chrom_idx < 0 || chrom_idx >= pop_size) {
-            fprintf(stderr, "Worker: Invalid chromosome index %d (pop_size=%d)\n", chrom_idx, pop_size);
-            sem_post(sem_result_local);
-            continue;
+        seen = epoch;
+        if (__atomic_load_n(&local_shared->shutdown_flag, __ATOMIC_ACQUIRE) ||
+            id >= local_shared->active_workers) {
+            break;
         }
         
-        Chromosome chrom;
-        int robot_count = local_shared->robot_count;
-        if (robot_count <= 0) {
-            fprintf(stderr, "Worker: Invalid robot_count %d\n", robot_count);
-            sem_post(sem_result_local);
-            continue;
-        }
+        run_batch_share(&view, lease, epoch);
         
-        chrom.missions = malloc(robot_count * sizeof(RobotMission));
-        if (!chrom.missions) {
-            fprintf(stderr, "Worker: Failed to allocate memory\n");
-            exit(1);
+        // The last worker out wakes the master
+        if (__atomic_add_fetch(&local_shared->workers_done, 1, __ATOMIC_ACQ_REL) >= local_shared->active_workers) {
+            futex_wake(&local_shared->workers_done, 1);
         }
-        
-        int max_surv = local_shared->max_survivors_per_robot;
-        if (max_surv <= 0) max_surv = 100;  // Safety fallback
-        
-        for (int r = 0; r < robot_count; r++) {
-            // Use flat indexing with local pointers
-            int pos_idx = chrom_idx * robot_count + r;
-            if (pos_idx < 0) {
-                fprintf(stderr, "Worker: Invalid position index %d\n", pos_idx);
-                free(chrom.missions);
-                sem_post(sem_result_local);
-                continue;
-            }
-            chrom.missions[r].robot_pos = local_robot_positions[pos_idx];
-            chrom.missions[r].survivor_count = local_survivor_counts[pos_idx];
-
-            chrom.missions[r].survivor_sequence = malloc(max_surv * sizeof(int));
-            if (!chrom.missions[r].survivor_sequence) {
-                // Free previously allocated arrays
-                for (int rr = 0; rr < r; rr++) {
-                    free(chrom.missions[rr].survivor_sequence);
-                }
-                free(chrom.missions);
-                fprintf(stderr, "Worker: Failed to allocate survivor_sequence memory\n");
-                exit(1);
-            }
-            int seq_base = chrom_idx * robot_count * max_surv + r * max_surv;
-            int actual_count = chrom.missions[r].survivor_count;
-            if (actual_count > max_surv) actual_count = max_surv;
-            for (int s = 0; s < actual_count; s++) {
-                chrom.missions[r].survivor_sequence[s] = local_survivor_sequences[seq_base + s];
+    }
+    
+    // _exit: atexit handlers registered by the master are not ours to run
+    _exit(0);
+}
+
+// Fixed names under /dev/shm that earlier builds shared between all runs
+static const char *const legacy_ipc_names[] = {
+    "ga_shared_mem", "ga_chromosomes_mem",
+    "sem.ga_work_sem", "sem.ga_result_sem", "sem.ga_mutex_sem"
+};
+
+// 1 if any live process still has path mapped
+static int ipc_path_mapped(const char *path) {
+    DIR *proc = opendir("/proc");
+    if (!proc) return 1;  // cannot tell, so leave it alone
+    
+    int mapped = 0;
+    struct dirent *entry;
+    char maps_path[sizeof(entry->d_name) + 16];
+    char line[512];
+    while (!mapped && (entry = readdir(proc)) != NULL) {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9') continue;
+        snprintf(maps_path, sizeof(maps_path), "/proc/%s/maps", entry->d_name);
+        FILE *maps = fopen(maps_path, "r");
+        if (!maps) continue;
+        while (fgets(line, sizeof(line), maps)) {
+            if (strstr(line, path)) {
+                mapped = 1;
+                break;
             }
         }
-        
-        // The building grid is a global variable accessible in forked processes
-        // Since we fork after allocating the grid, child processes inherit the pointer
-        double fitness = fitness_chromosome(&chrom, local_shared->robot_count, &local_shared->config);
-        
-        // Store result using local pointer
-        local_fitness_results[chrom_idx] = fitness;
-        
-        // Free allocated memory
-        for (int r = 0; r < local_shared->robot_count; r++) {
-            free(chrom.missions[r].survivor_sequence);
-        }
-        free(chrom.missions);
-        
-        // Signal result ready
-        if (sem_post(sem_result_local) != 0) {
-            perror("worker: sem_post (result)");
-            break;
+        fclose(maps);
+    }
+    closedir(proc);
+    return mapped;
+}
+
+// Unlink segments a crashed run of an earlier build left behind. The pool
+// itself uses anonymous mappings, so it never creates names of its own.
+static void sweep_stale_ipc_names(void) {
+    char path[64];
+    for (size_t i = 0; i < sizeof(legacy_ipc_names) / sizeof(legacy_ipc_names[0]); i++) {
+        snprintf(path, sizeof(path), "/dev/shm/%s", legacy_ipc_names[i]);
+        if (access(path, F_OK) != 0 || ipc_path_mapped(path)) continue;
+        if (unlink(path) == 0) {
+            printf("Removed stale IPC segment %s\n", path);
         }
     }
+}
+
+// Forks the worker for slot id; 0 on success. It treats batch seen as past,
+// so a replacement given the previous epoch joins the batch in progress.
+static int spawn_worker(int id, unsigned int seen) {
+    // Children would flush a copy of anything still buffered when they exit
+    fflush(stdout);
+    fflush(stderr);
     
-    // Cleanup worker resources
-    munmap(local_shared, local_shared->shm_data_size);
-    close(shm_fd);
-    munmap(local_chromosomes, local_shared->shm_chromosomes_size);
-    close(shm_chromosomes_fd);
-    sem_close(sem_work_local);
-    sem_close(sem_result_local);
-    sem_close(sem_mutex_local);
-    exit(0);
+    pid_t pid = fork();
+    if (pid == 0) {
+        reset_signal_handlers();
+        if (worker_cpus[id] >= 0) cpuset_pin(worker_cpus[id]);
+        worker_process(id, seen);
+        _exit(0);
+    }
+    if (pid < 0) {
+        perror("fork");
+        return -1;
+    }
+    worker_pids[id] = pid;
+    return 0;
 }
 
-// Initialize process pool
-int init_process_pool(int max_pop_size, int robot_count, int max_survivor_count, int pool_size, int max_survivors_per_robot) {
+// Initialize process pool. pool_size 0 sizes it from the CPUs this process
+// may use and lets it grow and shrink between batches; pool_max caps either.
+// generation_buffers is how many resident populations the engine may hold.
+int init_process_pool(int max_pop_size, int robot_count, int max_survivor_count, int pool_size,
+                      int pool_max, int pin_workers, int max_survivors_per_robot, int generation_buffers) {
     if (pool_initialized) {
         return 0;  
     }
     
-    num_worker_processes = pool_size > 0 ? pool_size : 1;  // Ensure at least one worker
+    int cpus = cpuset_available();
+    pool_auto = pool_size <= 0;
+    worker_capacity = pool_auto ? cpus : pool_size;
+    if (pool_max > 0 && worker_capacity > pool_max) worker_capacity = pool_max;
+    num_worker_processes = worker_capacity;
     
     // Check if building grid is allocated
     extern Cell ***building;
@@ -550,41 +610,55 @@ int init_process_pool(int max_pop_size, int robot_count, int max_survivor_count,
         return -1;  // Cannot use process pool without building grid
     }
     
+    sweep_stale_ipc_names();
+    
     // Initialize shared memory
-    if (init_shared_memory(max_pop_size, robot_count, max_survivor_count, num_worker_processes, max_survivors_per_robot) != 0) {
+    if (init_shared_memory(max_pop_size, robot_count, max_survivor_count, worker_capacity, max_survivors_per_robot) != 0) {
         return -1;
     }
+    // Without the arena batches are staged through the shared slots instead
+    init_population_arena(max_pop_size, robot_count, max_survivors_per_robot, generation_buffers);
+    shared_data->active_workers = num_worker_processes;
     
-    // Allocate array for worker PIDs
-    worker_pids = malloc(num_worker_processes * sizeof(pid_t));
-    if (!worker_pids) {
+    // Allocate per-worker slots
+    worker_pids = calloc(worker_capacity, sizeof(pid_t));
+    worker_cpus = malloc(worker_capacity * sizeof(int));
+    int *cpu_order = malloc(cpus * sizeof(int));
+    if (!worker_pids || !worker_cpus || !cpu_order) {
+        free(worker_pids);
+        free(worker_cpus);
+        free(cpu_order);
+        worker_pids = NULL;
+        worker_cpus = NULL;
         cleanup_shared_memory();
         return -1;
     }
     
+    // Worker i gets the i-th CPU, home NUMA node first
+    int cpu_count = pin_workers ? cpuset_list(cpu_order, cpus) : 0;
+    for (int i = 0; i < worker_capacity; i++) {
+        worker_cpus[i] = cpu_count > 0 ? cpu_order[i % cpu_count] : -1;
+    }
+    free(cpu_order);
+    
     // Create worker processes
     for (int i = 0; i < num_worker_processes; i++) {
-        pid_t pid = fork();
-        if (pid == 0) {
-            // Child process, worker
-            worker_process();
-            exit(0);
-        } else if (pid > 0) {
-            // Parent process, store worker PID
-            worker_pids[i] = pid;
-        } else {
-            perror("fork");
+        if (spawn_worker(i, 0) != 0) {
             for (int j = 0; j < i; j++) {
                 kill(worker_pids[j], SIGTERM);
             }
             free(worker_pids);
+            free(worker_cpus);
             worker_pids = NULL;
+            worker_cpus = NULL;
             cleanup_shared_memory();
             return -1;
         }
     }
     
     pool_initialized = 1;
+    printf("Fitness evaluation: %d worker processes%s%s\n", num_worker_processes,
+           pool_auto ? " (sized automatically)" : "", cpu_count > 0 ? ", pinned" : "");
     
     // Register signal handlers to ensure cleanup on interruption
     register_signal_handlers();
@@ -592,8 +666,43 @@ int init_process_pool(int max_pop_size, int robot_count, int max_survivor_count,
     return 0;
 }
 
+// Waits for worker pid to exit until deadline, then kills it. A pidfd
+// becomes readable when the process exits, so a healthy worker is reaped
+// the moment it leaves; kernels without pidfd_open poll waitpid instead.
+static void reap_worker(pid_t pid, double deadline) {
+    int pidfd = -1;
+#ifdef SYS_pidfd_open
+    pidfd = (int)syscall(SYS_pidfd_open, pid, 0);
+#endif
+    for (;;) {
+        pid_t waited = waitpid(pid, NULL, WNOHANG);
+        if (waited == pid || (waited < 0 && errno != EINTR)) break;
+        
+        double left = deadline - monotonic_seconds();
+        if (left <= 0.0) {
+            kill(pid, SIGKILL);
+            while (waitpid(pid, NULL, 0) < 0 && errno == EINTR) {
+            }
+            break;
+        }
+        if (pidfd >= 0) {
+            struct pollfd ready = {pidfd, POLLIN, 0};
+            poll(&ready, 1, (int)(left * 1000.0) + 1);
+        } else {
+            const struct timespec nap = {0, 100000};
+            nanosleep(&nap, NULL);
+        }
+    }
+    if (pidfd >= 0) close(pidfd);
+}
+
 // Shutdown process pool
 void shutdown_process_pool(void) {
+    net_eval_stop();
+    if (eval_threads) {
+        thread_pool_destroy(eval_threads);
+        eval_threads = NULL;
+    }
     if (!pool_initialized) {
         return;
     }
@@ -602,83 +711,19 @@ void shutdown_process_pool(void) {
     
     // Signal workers to shutdown
     if (shared_data) {
-        shared_data->shutdown_flag = 1;
+        __atomic_store_n(&shared_data->shutdown_flag, 1, __ATOMIC_RELEASE);
         
         // Wake up all workers (to exit)
-        if (sem_work != NULL && sem_work != SEM_FAILED) {
-            for (int i = 0; i < num_worker_processes; i++) {
-                sem_post(sem_work);
-            }
-        }
+        __atomic_add_fetch(&shared_data->work_epoch, 1, __ATOMIC_RELEASE);
+        futex_wake(&shared_data->work_epoch, INT_MAX);
     }
     
-    // Force kill all workers immediately
+    // Workers see the flag on the wake-up and leave; reap them as they go
     if (worker_pids) {
-        for (int i = 0; i < num_worker_processes; i++) {
+        double deadline = monotonic_seconds() + SHUTDOWN_GRACE_SECONDS;
+        for (int i = 0; i < worker_capacity; i++) {
             if (worker_pids[i] > 0) {
-                // Send SIGTERM first for graceful shutdown
-                kill(worker_pids[i], SIGTERM);
-            }
-        }
-        
-        // Wait a brief moment for graceful shutdown
-        usleep(100000);  // 100ms
-        
-        //  force kill any that didn't exit gracefully
-        for (int i = 0; i < num_worker_processes; i++) {
-            if (worker_pids[i] > 0) {
-                kill(worker_pids[i], SIGKILL);
-            }
-        }
-        
-        // Use a timeout loop to ensure we wait for all children
-        int wait_attempts = 0;
-        const int max_wait_attempts = 100;  // 10 seconds total (100 * 100ms)
-        
-        while (wait_attempts < max_wait_attempts) {
-            int all_reaped = 1;
-            
-            for (int i = 0; i < num_worker_processes; i++) {
-                if (worker_pids[i] > 0) {
-                    int status;
-                    pid_t waited = waitpid(worker_pids[i], &status, WNOHANG);
-                    
-                    if (waited == worker_pids[i]) {
-                        // This child is killed
-                        worker_pids[i] = 0;
-                    } else if (waited == 0) {
-                        // Child still alive
-                        all_reaped = 0;
-                    } else if (waited == -1 && errno == ECHILD) {
-                        // No such child 
-                        worker_pids[i] = 0;
-                    } else {
-                        if (errno != EINTR) {
-                            all_reaped = 0;
-                        }
-                    }
-                }
-            }
-            
-            if (all_reaped) {
-                break;  // All children killed
-            }
-            
-            // Wait a bit before trying again
-            usleep(100000);  // 100ms
-            wait_attempts++;
-        }
-        
-        // Force kill any remaining children that didn't exit
-        for (int i = 0; i < num_worker_processes; i++) {
-            if (worker_pids[i] > 0) {
-                kill(worker_pids[i], SIGKILL);
-                // Wait for it one more time
-                int status;
-                pid_t waited;
-                do {
-                    waited = waitpid(worker_pids[i], &status, 0);
-                } while (waited == -1 && errno == EINTR);
+                reap_worker(worker_pids[i], deadline);
                 worker_pids[i] = 0;
             }
         }
@@ -686,6 +731,8 @@ void shutdown_process_pool(void) {
         free(worker_pids);
         worker_pids = NULL;
     }
+    free(worker_cpus);
+    worker_cpus = NULL;
     
     // cleanup kill any zombie children
     pid_t pid;
@@ -698,72 +745,459 @@ void shutdown_process_pool(void) {
     num_worker_processes = 0;
 }
 
-// Parallel fitness computation using multiprocessing with process pool
-void compute_fitness_parallel_mp(Chromosome pop[], int pop_size, int robot_count, const Config *cfg,
-                                  const Node robot_starts[], const Survivor survivors[], int survivor_count) {
-    // Initialize process pool if not already done
-    static int pool_init_attempted = 0;
-    
-    if (!pool_init_attempted) {
-        int pool_size = (cfg && cfg->pool_size > 0) ? cfg->pool_size : 1;
-        int max_survivors_per_robot = (cfg && cfg->max_survivors_per_robot > 0) ? cfg->max_survivors_per_robot : 100;
-        // Calculate max survivors: max_survivors_per_robot * population_size
-        int calculated_max_survivors = max_survivors_per_robot * pop_size;
-        if (init_process_pool(pop_size, robot_count, calculated_max_survivors, pool_size, max_survivors_per_robot) != 0) {
-            pool_init_attempted = 1;
-            for (int i = 0; i < pop_size; i++) {
-                pop[i].fitness = fitness_chromosome(&pop[i], robot_count, cfg);
-            }
-            return;
-        }
-        pool_init_attempted = 1;
+// Bounded fitness memoization: direct-mapped table keyed by chromosome_hash.
+// An entry whose owner is >= 0 was claimed by a chromosome of the current
+// batch that is still being evaluated.
+typedef struct {
+    uint64_t hash;
+    double fitness;
+    int owner;
+} FitnessCacheEntry;
+
+static FitnessCacheEntry *fitness_cache = NULL;
+static uint64_t fitness_cache_mask = 0;
+static FitnessCacheStats last_cache_stats = {0};
+
+// Reusable per-call buffers: chromosomes to evaluate and in-batch duplicates
+static int *pending = NULL;
+static uint64_t *pending_hash = NULL;
+static int *duplicate_of = NULL;
+static int *net_leftover = NULL;
+static int pending_capacity = 0;
+
+static int fitness_cache_init(int requested) {
+    if (fitness_cache || requested <= 0) return 0;
+    
+    uint64_t capacity = 1;
+    while (capacity < (uint64_t)requested) capacity <<= 1;
+    fitness_cache = calloc(capacity, sizeof(FitnessCacheEntry));
+    if (!fitness_cache) return -1;
+    fitness_cache_mask = capacity - 1;
+    for (uint64_t i = 0; i < capacity; i++) {
+        fitness_cache[i].owner = -1;
+    }
+    return 0;
+}
+
+FitnessCacheStats fitness_cache_last_stats(void) {
+    return last_cache_stats;
+}
+
+static void evaluate_sequential(Chromosome pop[], const int indices[], int count,
+                                int robot_count, const Config *cfg) {
+    for (int k = 0; k < count; k++) {
+        Chromosome *c = &pop[indices[k]];
+        c->fitness = fitness_chromosome_cached(c, robot_count, cfg);
+    }
+}
+
+typedef struct {
+    Chromosome *pop;
+    const int *indices;
+    int robot_count;
+    const Config *cfg;
+} EvalBatch;
+
+static void evaluate_range(void *arg, int begin, int end) {
+    EvalBatch *batch = arg;
+    for (int k = begin; k < end; k++) {
+        Chromosome *c = &batch->pop[batch->indices[k]];
+        c->fitness = fitness_chromosome_cached(c, batch->robot_count, batch->cfg);
     }
+}
+
+// Evaluate pop[indices[0..count-1]] in place on the thread pool
+static void evaluate_on_threads(Chromosome pop[], const int indices[], int count,
+                                int robot_count, const Config *cfg) {
+    EvalBatch batch = {pop, indices, robot_count, cfg};
+    thread_pool_run(eval_threads, count, 0, evaluate_range, &batch);
+}
+
+static int init_thread_backend(const Config *cfg) {
+    int threads = cpuset_available();
+    if (cfg->pool_max > 0 && threads > cfg->pool_max) threads = cfg->pool_max;
     
-    // Check if pool is initialized
-    if (!pool_initialized || !shared_data) {
-        // Fallback to sequential
-        for (int i = 0; i < pop_size; i++) {
-            pop[i].fitness = fitness_chromosome(&pop[i], robot_count, cfg);
+    eval_threads = thread_pool_create(threads);
+    if (!eval_threads) return -1;
+    printf("Fitness evaluation: %d work-stealing threads\n", thread_pool_size(eval_threads));
+    return 0;
+}
+
+// Slots per claim: enough measured work per chunk to amortize the fetch_add,
+// but at least four chunks per worker so a slow chunk cannot hold up the batch
+static int chunk_size_for(int count) {
+    int balanced = count / (num_worker_processes * 4);
+    if (balanced < 1) balanced = 1;
+    if (item_seconds <= 0.0) return balanced;
+    
+    double amortized = CHUNK_TARGET_SECONDS / item_seconds;
+    if (amortized < 1.0) return 1;
+    return amortized < balanced ? (int)amortized : balanced;
+}
+
+// Automatic pools drop a worker when evaluations slow down against the
+// fastest seen (more runnable workers than free cores) and add one back
+// when they recover, but never keep more workers than the batch's measured
+// work can pay for. Growing needs twice the work that keeping a worker does,
+// so batch sizes near the threshold do not fork and retire every generation.
+// Runs between batches, while every worker is parked.
+static void resize_pool(int count) {
+    if (!pool_auto || item_seconds <= 0.0) return;
+    
+    int target = num_worker_processes;
+    int useful = (int)(count * item_seconds / MIN_WORKER_SECONDS);
+    if (item_seconds > CONTENDED_SLOWDOWN * best_item_seconds) {
+        target--;
+    } else if (item_seconds < 1.2 * best_item_seconds && useful >= 2 * (target + 1)) {
+        target++;
+    }
+    if (target > useful) target = useful;
+    if (target > worker_capacity) target = worker_capacity;
+    if (target < 1) target = 1;
+    
+    // Retired workers exit when the next batch wakes them; make sure an old
+    // one is gone before its slot is reused
+    for (int id = num_worker_processes; id < target; id++) {
+        if (worker_pids[id] > 0) {
+            waitpid(worker_pids[id], NULL, 0);
+            worker_pids[id] = 0;
+        }
+        if (spawn_worker(id, shared_data->work_epoch) != 0) {
+            target = id;
+            break;
         }
+    }
+    num_worker_processes = target;
+    shared_data->active_workers = target;
+}
+
+// 1 once every taking-part worker has finished its share of batch epoch
+static int batch_finished(unsigned int epoch) {
+    for (int id = 0; id < num_worker_processes; id++) {
+        if (__atomic_load_n(&shared_data->leases[id].done_epoch, __ATOMIC_ACQUIRE) != epoch) return 0;
+    }
+    return 1;
+}
+
+// Worker id is gone. If it had not finished batch epoch a replacement joins
+// the batch and re-runs the leased chunk; a chunk that keeps killing its
+// workers, or a replacement that cannot be forked, is run by the master.
+static void recover_worker(int id, unsigned int epoch) {
+    WorkerLease *lease = &shared_data->leases[id];
+    worker_pids[id] = 0;
+    if (lease->done_epoch == epoch) {
+        spawn_worker(id, epoch);
         return;
     }
     
-    // Update shared memory with new work
-    shared_data->pop_size = pop_size;
-    shared_data->robot_count = robot_count;
-    int calculated_max_survivors = cfg->max_survivors_per_robot * pop_size;
-    shared_data->survivor_count = (survivor_count < calculated_max_survivors) ? survivor_count : calculated_max_survivors;
+    int orphaned = lease->epoch == epoch && lease->end > lease->begin;
+    if (orphaned) {
+        fprintf(stderr, "Requeueing chromosomes %d-%d of worker %d\n", lease->begin, lease->end - 1, id);
+    }
+    if (lease->retries < LEASE_MAX_RETRIES && spawn_worker(id, epoch - 1) == 0) {
+        if (orphaned) lease->retries++;
+        return;
+    }
+    
+    WorkerView view = worker_view();
+    run_batch_share(&view, lease, epoch);
+    lease->retries = 0;
+    spawn_worker(id, epoch);
+}
+
+// Reaps workers that died during batch epoch and kills ones that made no
+// progress for far longer than a chunk should take (a lease held that long,
+// or no claim since the batch started), then recovers both
+static void check_workers(unsigned int epoch, double batch_started) {
+    double now = monotonic_seconds();
+    double expected = shared_data->chunk_size * item_seconds;
+    double stall = LEASE_MIN_SECONDS + LEASE_SLACK * expected;
+    
+    for (int id = 0; id < num_worker_processes; id++) {
+        pid_t pid = worker_pids[id];
+        int status = 0;
+        if (pid > 0 && waitpid(pid, &status, WNOHANG) == 0) {
+            const WorkerLease *lease = &shared_data->leases[id];
+            if (__atomic_load_n(&lease->done_epoch, __ATOMIC_ACQUIRE) == epoch) continue;
+            double since = lease->epoch == epoch ? lease->started_ns * 1e-9 : batch_started;
+            if (now - since < stall) continue;
+            
+            fprintf(stderr, "Worker %d (pid %d) stalled for %.0f s, killing it\n", id, (int)pid, now - since);
+            kill(pid, SIGKILL);
+            waitpid(pid, &status, 0);
+        }
+        
+        if (pid <= 0) {
+            fprintf(stderr, "Worker %d is not running, replacing it\n", id);
+        } else if (WIFSIGNALED(status)) {
+            fprintf(stderr, "Worker %d (pid %d) killed by signal %d, replacing it\n", id, (int)pid, WTERMSIG(status));
+        } else {
+            fprintf(stderr, "Worker %d (pid %d) exited with status %d, replacing it\n", id, (int)pid, WEXITSTATUS(status));
+        }
+        recover_worker(id, epoch);
+    }
+}
+
+// Sleeps until the last worker out signals the end of batch epoch, waking
+// every LEASE_POLL_SECONDS to catch workers that died or hung on the way
+static void wait_for_batch(unsigned int epoch) {
+    const struct timespec poll = {0, (long)(LEASE_POLL_SECONDS * 1e9)};
+    double started = monotonic_seconds();
+    for (;;) {
+        int done = __atomic_load_n(&shared_data->workers_done, __ATOMIC_ACQUIRE);
+        if (done >= num_worker_processes && batch_finished(epoch)) return;
+        if (futex_wait(&shared_data->workers_done, (unsigned int)done, &poll) != 0 && errno == ETIMEDOUT) {
+            check_workers(epoch, started);
+            if (batch_finished(epoch)) return;
+        }
+    }
+}
+
+// Batch on the process pool between dispatch_to_pool and collect_from_pool
+static struct {
+    Chromosome *pop;
+    const int *indices;
+    int count;
+    int robot_count;
+    int resident;
+    unsigned int epoch;
+} pool_batch;
+
+// Starts pop[indices[0..count-1]] on the process pool and returns
+static void dispatch_to_pool(Chromosome pop[], const int indices[], int count, int robot_count) {
+    // Resident populations are evaluated where they lie; others are staged
+    int resident = shared_population_index(pop) >= 0;
+    shared_data->pop_size = count;
+    if (resident) {
+        memcpy(batch_indices, indices, count * sizeof(int));
+        shared_data->batch_pop = pop;
+    } else {
+        shared_data->batch_pop = NULL;
+        copy_population_to_shared(pop, indices, count, robot_count);
+    }
+    
+    resize_pool(count);
+    shared_data->chunk_size = chunk_size_for(count);
     shared_data->next_chromosome = 0;
-    shared_data->shutdown_flag = 0;  
-    // Copy configuration to shared memory
-    memcpy(&shared_data->config, cfg, sizeof(Config));
-    // Store max_survivors_per_robot for worker processes
-    shared_data->max_survivors_per_robot = cfg->max_survivors_per_robot;
+    shared_data->busy_ns = 0;
+    shared_data->workers_done = 0;
     
-    // Copy population to shared memory
-    copy_population_to_shared(pop, pop_size, robot_count, robot_starts, survivors);
+    pool_batch.pop = pop;
+    pool_batch.indices = indices;
+    pool_batch.count = count;
+    pool_batch.robot_count = robot_count;
+    pool_batch.resident = resident;
     
-    // Signal workers to start
-    for (int i = 0; i < pop_size; i++) {
-        if (sem_post(sem_work) != 0) {
-            perror("sem_post (work)");
-            // Fallback to sequential
+    // One wake-up starts the batch; the epoch bump publishes the slots above
+    pool_batch.epoch = __atomic_add_fetch(&shared_data->work_epoch, 1, __ATOMIC_RELEASE);
+    futex_wake(&shared_data->work_epoch, INT_MAX);
+}
+
+// Waits for the dispatched batch and brings its results back
+static void collect_from_pool(void) {
+    int count = pool_batch.count;
+    wait_for_batch(pool_batch.epoch);
+    
+    // Running average of the cost per evaluation sizes the next batch's chunks
+    double measured = shared_data->busy_ns * 1e-9 / count;
+    item_seconds = item_seconds > 0.0 ? 0.75 * item_seconds + 0.25 * measured : measured;
+    if (measured > 0.0 && (best_item_seconds <= 0.0 || measured < best_item_seconds)) {
+        best_item_seconds = measured;
+    }
+    
+    // Copy results back
+    if (!pool_batch.resident) {
+        copy_fitness_from_shared(pool_batch.pop, pool_batch.indices, count, pool_batch.robot_count);
+    }
+}
+
+void fitness_backend_start(int pop_size, int robot_count, const Config *cfg,
+                           const Node robot_starts[], const Survivor survivors[], int survivor_count) {
+    static int backend_start_attempted = 0;
+    if (backend_start_attempted) return;
+    backend_start_attempted = 1;
+    
+    int pool_size = (cfg && cfg->pool_size > 0) ? cfg->pool_size : 0;
+    int max_survivors_per_robot = (cfg && cfg->max_survivors_per_robot > 0) ? cfg->max_survivors_per_robot : 100;
+    // Calculate max survivors: max_survivors_per_robot * population_size
+    int calculated_max_survivors = max_survivors_per_robot * pop_size;
+    if (cfg->eval_backend == EVAL_BACKEND_THREAD && init_thread_backend(cfg) != 0) {
+        fprintf(stderr, "Thread backend unavailable, using the process pool\n");
+    }
+    // Evaluators first: their daemons fork before the pool's shared memory
+    // exists. The pool still starts and scores what they hand back.
+    if (cfg->eval_backend == EVAL_BACKEND_TCP) {
+        int ready = net_eval_start(cfg, robot_count);
+        if (ready > 0) {
+            printf("Fitness evaluation: %d evaluators over TCP, process pool as fallback\n", ready);
+        } else {
+            fprintf(stderr, "No evaluator reachable, using the process pool\n");
+        }
+    }
+    // The pipelined engine holds parents, the batch in flight and the one being bred
+    int generation_buffers = cfg->ga_engine == GA_ENGINE_PIPELINED ? 3 : 2;
+    if (!eval_threads &&
+        init_process_pool(pop_size, robot_count, calculated_max_survivors, pool_size,
+                          cfg->pool_max, cfg->pin_workers, max_survivors_per_robot, generation_buffers) == 0) {
+        // Run-wide data is written once; batches only carry chromosomes
+        shared_data->robot_count = robot_count;
+        shared_data->survivor_count = (survivor_count < calculated_max_survivors) ? survivor_count : calculated_max_survivors;
+        shared_data->max_survivors_per_robot = max_survivors_per_robot;
+        memcpy(&shared_data->config, cfg, sizeof(Config));
+        memcpy(shared_data->robot_starts, robot_starts, robot_count * sizeof(Node));
+        memcpy(shared_data->survivors, survivors, shared_data->survivor_count * sizeof(Survivor));
+    }
+    fitness_cache_init(cfg->fitness_cache_size);
+}
+
+// Batch between fitness_batch_begin and fitness_batch_finish
+static struct {
+    Chromosome *pop;
+    int pop_size;
+    int robot_count;
+    int pending_count;
+    FitnessCacheStats stats;
+    int on_pool;            // still running on the process pool
+} open_batch;
+
+void fitness_batch_begin(Chromosome pop[], int pop_size, int robot_count, const Config *cfg,
+                         const Node robot_starts[], const Survivor survivors[], int survivor_count) {
+    fitness_backend_start(pop_size, robot_count, cfg, robot_starts, survivors, survivor_count);
+    open_batch.pop = pop;
+    open_batch.pop_size = 0;
+    open_batch.pending_count = 0;
+    open_batch.on_pool = 0;
+    
+    if (pop_size > pending_capacity) {
+        int *new_pending = realloc(pending, pop_size * sizeof(int));
+        if (new_pending) pending = new_pending;
+        uint64_t *new_pending_hash = realloc(pending_hash, pop_size * sizeof(uint64_t));
+        if (new_pending_hash) pending_hash = new_pending_hash;
+        int *new_duplicate_of = realloc(duplicate_of, pop_size * sizeof(int));
+        if (new_duplicate_of) duplicate_of = new_duplicate_of;
+        int *new_net_leftover = realloc(net_leftover, pop_size * sizeof(int));
+        if (new_net_leftover) net_leftover = new_net_leftover;
+        if (!new_pending || !new_pending_hash || !new_duplicate_of || !new_net_leftover) {
+            // No room to track the batch: score it here, bypassing the cache,
+            // so no caller is left with stale fitness values
+            fprintf(stderr, "Failed to allocate fitness dispatch buffers, evaluating sequentially\n");
+            FitnessCacheStats stats = {pop_size, 0, 0, 0};
             for (int i = 0; i < pop_size; i++) {
-                pop[i].fitness = fitness_chromosome(&pop[i], robot_count, cfg);
+                if (pop[i].fitness_valid) {
+                    stats.reused++;
+                    continue;
+                }
+                pop[i].fitness = fitness_chromosome_cached(&pop[i], robot_count, cfg);
+                pop[i].fitness_valid = 1;
+                pop[i].fidelity = FIDELITY_ESTIMATE;
+                stats.evaluated++;
             }
+            open_batch.stats = stats;
             return;
         }
+        pending_capacity = pop_size;
     }
+    open_batch.pop_size = pop_size;
+    open_batch.robot_count = robot_count;
     
-    // Wait for all results
+    // Skip chromosomes whose fitness is still valid or already known
+    FitnessCacheStats stats = {pop_size, 0, 0, 0};
+    int pending_count = 0;
     for (int i = 0; i < pop_size; i++) {
-        if (sem_wait(sem_result) != 0) {
-            perror("sem_wait (result)");
-            break;
+        duplicate_of[i] = -1;
+        if (pop[i].fitness_valid) {
+            stats.reused++;
+            continue;
+        }
+        if (fitness_cache) {
+            uint64_t hash = chromosome_hash(&pop[i], robot_count);
+            FitnessCacheEntry *entry = &fitness_cache[hash & fitness_cache_mask];
+            if (entry->hash == hash && entry->owner >= 0) {
+                // Identical to a chromosome evaluated in this batch
+                duplicate_of[i] = entry->owner;
+                stats.cache_hits++;
+                continue;
+            }
+            if (entry->hash == hash) {
+                pop[i].fitness = entry->fitness;
+                pop[i].fitness_valid = 1;
+                pop[i].fidelity = FIDELITY_ESTIMATE;
+                stats.cache_hits++;
+                continue;
+            }
+            entry->hash = hash;
+            entry->owner = i;
+            pending_hash[pending_count] = hash;
         }
+        pending[pending_count++] = i;
     }
+    stats.evaluated = pending_count;
+    open_batch.pending_count = pending_count;
+    open_batch.stats = stats;
     
-    // Copy results back
-    copy_fitness_from_shared(pop, pop_size);
+    if (pending_count > 0) {
+        if (net_eval_active()) {
+            // Evaluators score the batch before this returns; the pool or
+            // the master takes whatever they could not
+            int left = net_eval_run(pop, pending, pending_count, robot_count, net_leftover);
+            if (left > 0 && pool_initialized && shared_data) {
+                dispatch_to_pool(pop, net_leftover, left, robot_count);
+                collect_from_pool();
+            } else if (left > 0) {
+                evaluate_sequential(pop, net_leftover, left, robot_count, cfg);
+            }
+        } else if (eval_threads) {
+            evaluate_on_threads(pop, pending, pending_count, robot_count, cfg);
+        } else if (!pool_initialized || !shared_data) {
+            // Fallback to sequential
+            evaluate_sequential(pop, pending, pending_count, robot_count, cfg);
+        } else {
+            dispatch_to_pool(pop, pending, pending_count, robot_count);
+            open_batch.on_pool = 1;
+        }
+    }
+}
+
+void fitness_batch_finish(void) {
+    Chromosome *pop = open_batch.pop;
+    int pop_size = open_batch.pop_size;
+    int robot_count = open_batch.robot_count;
+    int pending_count = open_batch.pending_count;
+    if (open_batch.on_pool) {
+        collect_from_pool();
+        open_batch.on_pool = 0;
+    }
+    
+    // Publish results to the cache and to in-batch duplicates
+    for (int k = 0; k < pending_count; k++) {
+        Chromosome *c = &pop[pending[k]];
+        c->fitness_valid = 1;
+        c->fidelity = FIDELITY_ESTIMATE;
+        if (fitness_cache) {
+            uint64_t hash = pending_hash[k];
+            FitnessCacheEntry *entry = &fitness_cache[hash & fitness_cache_mask];
+            entry->hash = hash;
+            entry->fitness = c->fitness;
+            entry->owner = -1;
+        }
+    }
+    for (int i = 0; i < pop_size; i++) {
+        if (duplicate_of[i] >= 0) {
+            const Chromosome *src = &pop[duplicate_of[i]];
+            pop[i].fitness = src->fitness;
+            pop[i].fitness_valid = 1;
+            pop[i].fidelity = FIDELITY_ESTIMATE;
+            memcpy(pop[i].scores, src->scores, robot_count * sizeof(MissionScore));
+        }
+    }
     
+    last_cache_stats = open_batch.stats;
+    open_batch.pop_size = 0;
+}
+
+// Parallel fitness computation using multiprocessing with process pool
+void compute_fitness_parallel_mp(Chromosome pop[], int pop_size, int robot_count, const Config *cfg,
+                                  const Node robot_starts[], const Survivor survivors[], int survivor_count) {
+    fitness_batch_begin(pop, pop_size, robot_count, cfg, robot_starts, survivors, survivor_count);
+    fitness_batch_finish();
 }
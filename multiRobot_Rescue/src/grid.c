@@ -1,6 +1,16 @@
 #include "all_headers.h"
 
 Cell ***building = NULL;
+unsigned char *voxels = NULL;
+
+// Summed-area tables: entry (x, y, z) of a (grid_x + 1) * (grid_y + 1) *
+// (grid_z + 1) volume holds the totals over cells [0, x) * [0, y) * [0, z)
+typedef struct {
+    int obstacles;
+    int risk;
+} IntegralEntry;
+
+static IntegralEntry *integrals = NULL;
 
 int allocate_grid(const Config *cfg) {
     if (!cfg) return -1;
@@ -72,13 +82,117 @@ void free_grid(const Config *cfg) {
     }
     free(building);
     building = NULL;
+    free(voxels);
+    voxels = NULL;
+    free(integrals);
+    integrals = NULL;
 }
 
-void generate_obstacles(const Config *cfg) {
-    if (!building || !cfg) return;
+static int pack_voxels(const Config *cfg) {
+    
+    size_t cells = (size_t)cfg->grid_x * cfg->grid_y * cfg->grid_z;
+    unsigned char *packed = realloc(voxels, cells);
+    if (!packed) return -1;
+    voxels = packed;
+    
+    size_t i = 0;
+    for (int z = 0; z < cfg->grid_z; z++) {
+        for (int y = 0; y < cfg->grid_y; y++) {
+            for (int x = 0; x < cfg->grid_x; x++) {
+                const Cell *cell = &building[z][y][x];
+                voxels[i++] = (cell->obstacle ? VOXEL_OBSTACLE : 0) |
+                              (unsigned char)((cell->risk & 0x3) << VOXEL_RISK_SHIFT);
+            }
+        }
+    }
+    return 0;
+}
+
+static size_t integral_index(int x, int y, int z, const Config *cfg) {
+    return ((size_t)z * (cfg->grid_y + 1) + y) * (cfg->grid_x + 1) + x;
+}
+
+static int build_integrals(const Config *cfg) {
+    size_t entries = (size_t)(cfg->grid_x + 1) * (cfg->grid_y + 1) * (cfg->grid_z + 1);
+    IntegralEntry *table = realloc(integrals, entries * sizeof(IntegralEntry));
+    if (!table) return -1;
+    integrals = table;
+    
+    // The x = 0, y = 0 and z = 0 faces are empty prefixes
+    memset(integrals, 0, entries * sizeof(IntegralEntry));
+    
+    // Inclusion-exclusion over the seven lower neighbours
+    for (int z = 1; z <= cfg->grid_z; z++) {
+        for (int y = 1; y <= cfg->grid_y; y++) {
+            for (int x = 1; x <= cfg->grid_x; x++) {
+                const Cell *cell = &building[z - 1][y - 1][x - 1];
+                IntegralEntry *e = &integrals[integral_index(x, y, z, cfg)];
+                const IntegralEntry *c001 = &integrals[integral_index(x - 1, y, z, cfg)];
+                const IntegralEntry *c010 = &integrals[integral_index(x, y - 1, z, cfg)];
+                const IntegralEntry *c100 = &integrals[integral_index(x, y, z - 1, cfg)];
+                const IntegralEntry *c011 = &integrals[integral_index(x - 1, y - 1, z, cfg)];
+                const IntegralEntry *c101 = &integrals[integral_index(x - 1, y, z - 1, cfg)];
+                const IntegralEntry *c110 = &integrals[integral_index(x, y - 1, z - 1, cfg)];
+                const IntegralEntry *c111 = &integrals[integral_index(x - 1, y - 1, z - 1, cfg)];
+                e->obstacles = (cell->obstacle ? 1 : 0) +
+                               c001->obstacles + c010->obstacles + c100->obstacles -
+                               c011->obstacles - c101->obstacles - c110->obstacles +
+                               c111->obstacles;
+                e->risk = cell->risk +
+                          c001->risk + c010->risk + c100->risk -
+                          c011->risk - c101->risk - c110->risk +
+                          c111->risk;
+            }
+        }
+    }
+    return 0;
+}
+
+int grid_rebuild_indexes(const Config *cfg) {
+    if (!building || !cfg) return -1;
+    if (pack_voxels(cfg) != 0 || build_integrals(cfg) != 0) return -1;
+    return 0;
+}
+
+static int clamp_cell(int v, int size) {
+    if (v < 0) return 0;
+    if (v >= size) return size - 1;
+    return v;
+}
+
+RegionStats grid_box_stats(Node a, Node b, const Config *cfg) {
+    RegionStats stats = {0, 0, 0};
+    if (!integrals || !cfg) return stats;
+    
+    // Half-open bounds [x0, x1) etc. in table coordinates
+    int x0 = clamp_cell(a.x < b.x ? a.x : b.x, cfg->grid_x);
+    int y0 = clamp_cell(a.y < b.y ? a.y : b.y, cfg->grid_y);
+    int z0 = clamp_cell(a.z < b.z ? a.z : b.z, cfg->grid_z);
+    int x1 = clamp_cell(a.x > b.x ? a.x : b.x, cfg->grid_x) + 1;
+    int y1 = clamp_cell(a.y > b.y ? a.y : b.y, cfg->grid_y) + 1;
+    int z1 = clamp_cell(a.z > b.z ? a.z : b.z, cfg->grid_z) + 1;
+    
+    const IntegralEntry *e111 = &integrals[integral_index(x1, y1, z1, cfg)];
+    const IntegralEntry *e011 = &integrals[integral_index(x0, y1, z1, cfg)];
+    const IntegralEntry *e101 = &integrals[integral_index(x1, y0, z1, cfg)];
+    const IntegralEntry *e110 = &integrals[integral_index(x1, y1, z0, cfg)];
+    const IntegralEntry *e001 = &integrals[integral_index(x0, y0, z1, cfg)];
+    const IntegralEntry *e010 = &integrals[integral_index(x0, y1, z0, cfg)];
+    const IntegralEntry *e100 = &integrals[integral_index(x1, y0, z0, cfg)];
+    const IntegralEntry *e000 = &integrals[integral_index(x0, y0, z0, cfg)];
+    
+    stats.cells = (x1 - x0) * (y1 - y0) * (z1 - z0);
+    stats.obstacles = e111->obstacles - e011->obstacles - e101->obstacles - e110->obstacles +
+                      e001->obstacles + e010->obstacles + e100->obstacles - e000->obstacles;
+    stats.risk = e111->risk - e011->risk - e101->risk - e110->risk +
+                 e001->risk + e010->risk + e100->risk - e000->risk;
+    return stats;
+}
+
+void generate_obstacles(const Config *cfg, Rng *rng) {
+    if (!building || !cfg || !rng) return;
     
     // obstacle_density is between 0.0 and 1.0
-    srand(time(NULL));
     
     int total_cells = cfg->grid_x * cfg->grid_y * cfg->grid_z;
     
@@ -123,7 +237,7 @@ void generate_obstacles(const Config *cfg) {
     
     // Shuffle the cell list 
     for (int i = valid_cells - 1; i > 0; i--) {
-        int j = rand() % (i + 1);
+        int j = rng_below(rng, i + 1);
         CellPos temp = cell_list[i];
         cell_list[i] = cell_list[j];
         cell_list[j] = temp;
@@ -192,8 +306,8 @@ void assign_risk_from_obstacles(const Config *cfg) {
     }
 }
 
-void simulate_sensors(const Config *cfg) {
-    if (!building || !cfg) return;
+void simulate_sensors(const Config *cfg, Rng *rng) {
+    if (!building || !cfg || !rng) return;
     
     // Simulate heat and CO2 sensors    
     for (int z = 0; z < cfg->grid_z; z++) {
@@ -205,8 +319,8 @@ void simulate_sensors(const Config *cfg) {
                     continue;
                 }
                 
-                building[z][y][x].heat = (float)rand() / RAND_MAX;
-                building[z][y][x].co2 = (float)rand() / RAND_MAX;
+                building[z][y][x].heat = (float)rng_uniform(rng);
+                building[z][y][x].co2 = (float)rng_uniform(rng);
             }
         }
     }
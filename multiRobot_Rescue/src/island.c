@@ -0,0 +1,421 @@
+#include "all_headers.h"
+
+// How often the parent forwards island bests to the best-plan slot
+#define ISLAND_POLL_MS 10
+
+// Per-island header in the shared segment
+typedef struct {
+    unsigned int seq;            // seqlock: odd while the owner rewrites its migrants
+    int migrant_count;           // valid migrants in the mailbox
+    int published_generation;    // generation of the current migrants
+    int generations_run;
+    int migrants_accepted;
+    int result_count;            // individuals written to the result area
+    double best_fitness;
+    unsigned int best_seq;       // seqlock over the island's best plan slot
+    int best_generation;
+    int best_fidelity;           // FitnessFidelity of the best plan (not packed)
+} IslandHeader;
+
+typedef struct {
+    int island_count;
+    int robot_count;
+    int max_survivors_per_robot;
+    int migration_size;
+    size_t slot_bytes;           // one packed chromosome
+    IslandHeader *headers;
+    char *mailboxes;             // island_count * migration_size slots
+    char *bests;                 // island_count slots, each island's best plan so far
+    char *results;               // pop_size slots, island i starts at result_offset[i]
+    int *result_offset;
+    size_t total_bytes;
+    void *base;
+} IslandShared;
+
+// Packed chromosome: fitness, then robot positions, counts and gene slots
+static size_t packed_size(int robot_count, int max_survivors_per_robot) {
+    size_t bytes = sizeof(double) + robot_count * (sizeof(Node) + sizeof(int)) +
+                   (size_t)robot_count * max_survivors_per_robot * sizeof(int);
+    return (bytes + 7) & ~(size_t)7;
+}
+
+static void pack_chromosome(char *slot, const Chromosome *c, int robot_count, int max_surv) {
+    memcpy(slot, &c->fitness, sizeof(double));
+    Node *positions = (Node *)(slot + sizeof(double));
+    int *counts = (int *)(positions + robot_count);
+    int *genes = counts + robot_count;
+    for (int r = 0; r < robot_count; r++) {
+        positions[r] = c->missions[r].robot_pos;
+        counts[r] = c->missions[r].survivor_count;
+        memcpy(&genes[r * max_surv], c->missions[r].survivor_sequence, max_surv * sizeof(int));
+    }
+}
+
+static void unpack_chromosome(Chromosome *c, const char *slot, int robot_count, int max_surv) {
+    memcpy(&c->fitness, slot, sizeof(double));
+    const Node *positions = (const Node *)(slot + sizeof(double));
+    const int *counts = (const int *)(positions + robot_count);
+    const int *genes = counts + robot_count;
+    for (int r = 0; r < robot_count; r++) {
+        c->missions[r].robot_pos = positions[r];
+        c->missions[r].survivor_count = counts[r];
+        memcpy(c->missions[r].survivor_sequence, &genes[r * max_surv], max_surv * sizeof(int));
+        c->scores[r].dirty = 1;
+    }
+    if (c->tour) tour_from_missions(c, robot_count);
+    // The sender's fidelity is not packed; an exact score is redone if it ranks high
+    c->fitness_valid = 1;
+    c->fidelity = FIDELITY_ESTIMATE;
+}
+
+static char *mailbox_slot(const IslandShared *sh, int island, int k) {
+    return sh->mailboxes + ((size_t)island * sh->migration_size + k) * sh->slot_bytes;
+}
+
+// Publish the island's best individuals (pop sorted best first)
+static void publish_migrants(IslandShared *sh, int island, const Chromosome pop[], int count, int gen) {
+    IslandHeader *h = &sh->headers[island];
+    unsigned int seq = h->seq;
+    
+    __atomic_store_n(&h->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    for (int k = 0; k < count; k++) {
+        pack_chromosome(mailbox_slot(sh, island, k), &pop[k], sh->robot_count, sh->max_survivors_per_robot);
+    }
+    h->migrant_count = count;
+    h->published_generation = gen;
+    __atomic_store_n(&h->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+// Publish the island's best plan for the parent to forward to the best-plan slot
+static void publish_best(IslandShared *sh, int island, const Chromosome *best, int gen) {
+    IslandHeader *h = &sh->headers[island];
+    unsigned int seq = h->best_seq;
+    
+    __atomic_store_n(&h->best_seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    pack_chromosome(sh->bests + island * sh->slot_bytes, best, sh->robot_count, sh->max_survivors_per_robot);
+    h->best_generation = gen;
+    h->best_fidelity = best->fidelity;
+    __atomic_store_n(&h->best_seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+// Copy another island's mailbox into staging; returns migrants read, 0 if
+// nothing new or the owner was mid-write (we simply try again next time)
+static int fetch_migrants(const IslandShared *sh, int source, char *staging, int *last_seen_generation) {
+    const IslandHeader *h = &sh->headers[source];
+    unsigned int seq1 = __atomic_load_n(&h->seq, __ATOMIC_ACQUIRE);
+    if (seq1 & 1) return 0;
+    
+    int count = h->migrant_count;
+    int gen = h->published_generation;
+    if (count <= 0 || gen <= *last_seen_generation) return 0;
+    memcpy(staging, mailbox_slot(sh, source, 0), count * sh->slot_bytes);
+    
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&h->seq, __ATOMIC_RELAXED) != seq1) return 0;
+    
+    *last_seen_generation = gen;
+    return count;
+}
+
+// Evaluate individuals whose fitness is stale
+static void evaluate_island(Chromosome pop[], int size, int robot_count, const Config *cfg) {
+    for (int i = 0; i < size; i++) {
+        if (!pop[i].fitness_valid) {
+            pop[i].fitness = fitness_chromosome_cached(&pop[i], robot_count, cfg);
+            pop[i].fitness_valid = 1;
+        }
+    }
+}
+
+// Body of one island process
+static void run_island(IslandShared *sh, int island, int generations, StopCriteria *stop,
+                       const Chromosome seed_pop[],
+                       int size, double mutation_rate, int elitism_pct,
+                       const Node robot_starts[], const Survivor survivors[],
+                       int survivor_count, const Config *cfg, Rng *rng) {
+    int robot_count = sh->robot_count;
+    int max_surv = sh->max_survivors_per_robot;
+    IslandHeader *header = &sh->headers[island];
+    
+    int elite_count = (size * elitism_pct) / 100;
+    if (elite_count < 1) elite_count = 1;
+    if (elite_count >= size) elite_count = size - 1;
+    int child_count = size - elite_count;
+    int migrants = sh->migration_size < size - elite_count ? sh->migration_size : size - elite_count;
+    
+    Chromosome *cur = allocate_population(size, robot_count, max_surv);
+    Chromosome *next = allocate_population(size, robot_count, max_surv);
+    if (cur && next && seed_pop[0].tour &&
+        (tour_attach(cur, size, seed_pop[0].tour_length) != 0 ||
+         tour_attach(next, size, seed_pop[0].tour_length) != 0)) {
+        _exit(1);
+    }
+    int *parent_idx = malloc(2 * child_count * sizeof(int));
+    char *staging = malloc((sh->migration_size > 0 ? sh->migration_size : 1) * sh->slot_bytes);
+    if (!cur || !next || !parent_idx || !staging) {
+        fprintf(stderr, "Island %d: failed to allocate subpopulation\n", island);
+        _exit(1);
+    }
+    
+    for (int i = 0; i < size; i++) {
+        copy_chromosome(&cur[i], &seed_pop[i], robot_count, max_surv);
+    }
+    evaluate_island(cur, size, robot_count, cfg);
+    sort_by_fitness(cur, size);
+    fitness_refine_top(cur, size, cfg->exact_top_k, elite_count, robot_count, cfg);
+    
+    publish_best(sh, island, &cur[0], 0);
+    double published_fitness = cur[0].fitness;
+    int published_fidelity = cur[0].fidelity;
+    
+    // Newest migrant generation taken from each source island
+    int *last_seen_generation = calloc(sh->island_count, sizeof(int));
+    if (!last_seen_generation) {
+        fprintf(stderr, "Island %d: failed to allocate subpopulation\n", island);
+        _exit(1);
+    }
+    for (int gen = 1; gen <= generations; gen++) {
+        for (int i = 0; i < elite_count; i++) {
+            copy_chromosome(&next[i], &cur[i], robot_count, max_surv);
+            if ((cfg->local_search & LOCAL_SEARCH_ELITES) && local_search(&next[i], robot_count, cfg) > 0) {
+                next[i].fitness = fitness_chromosome_cached(&next[i], robot_count, cfg);
+                next[i].fitness_valid = 1;
+            }
+        }
+        
+        tournament_select(cur, size, parent_idx, 2 * child_count, rng);
+        for (int i = elite_count; i < size; i++) {
+            const int *pair = &parent_idx[2 * (i - elite_count)];
+            breed_child(&next[i], &cur[pair[0]], &cur[pair[1]], robot_count, survivor_count,
+                        mutation_rate, robot_starts, survivors, cfg,
+                        cfg->local_search & LOCAL_SEARCH_CHILDREN, rng);
+        }
+        
+        evaluate_island(next, size, robot_count, cfg);
+        sort_by_fitness(next, size);
+        fitness_refine_top(next, size, cfg->exact_top_k, elite_count, robot_count, cfg);
+        
+        Chromosome *temp = cur;
+        cur = next;
+        next = temp;
+        
+        if (migrants > 0 && gen % cfg->migration_interval == 0) {
+            publish_migrants(sh, island, cur, migrants, gen);
+            
+            int source = (island + sh->island_count - 1) % sh->island_count;
+            if (cfg->migration_topology == MIGRATION_RANDOM) {
+                source = rng_below(rng, sh->island_count - 1);
+                if (source >= island) source++;
+            }
+            
+            // Migrants replace the worst individuals
+            int received = fetch_migrants(sh, source, staging, &last_seen_generation[source]);
+            if (received > migrants) received = migrants;
+            for (int k = 0; k < received; k++) {
+                unpack_chromosome(&cur[size - 1 - k], staging + k * sh->slot_bytes, robot_count, max_surv);
+            }
+            if (received > 0) {
+                sort_by_fitness(cur, size);
+                fitness_refine_top(cur, size, cfg->exact_top_k, elite_count, robot_count, cfg);
+                header->migrants_accepted += received;
+            }
+        }
+        
+        header->generations_run = gen;
+        header->best_fitness = cur[0].fitness;
+        if (cur[0].fidelity > published_fidelity ||
+            (cur[0].fidelity == published_fidelity && cur[0].fitness > published_fitness)) {
+            publish_best(sh, island, &cur[0], gen);
+            published_fitness = cur[0].fitness;
+            published_fidelity = cur[0].fidelity;
+        }
+        
+        // Each island applies the budget and convergence tests on its own
+        if (stop_criteria_check(stop, cur, size, robot_count, gen)) break;
+    }
+    stop_criteria_free(stop);
+    
+    // Hand the final subpopulation back to the parent
+    char *results = sh->results + sh->result_offset[island] * sh->slot_bytes;
+    for (int i = 0; i < size; i++) {
+        pack_chromosome(results + i * sh->slot_bytes, &cur[i], robot_count, max_surv);
+    }
+    header->result_count = size;
+    header->best_fitness = cur[0].fitness;
+    
+    free_population(cur, size, robot_count);
+    free_population(next, size, robot_count);
+    free(parent_idx);
+    free(staging);
+    free(last_seen_generation);
+}
+
+// Forwards every island best published since the last look to the
+// best-plan slot; one mid-write is simply picked up on the next call
+static void forward_island_bests(const IslandShared *sh, unsigned int seen[], Chromosome *scratch) {
+    for (int i = 0; i < sh->island_count; i++) {
+        const IslandHeader *h = &sh->headers[i];
+        unsigned int seq1 = __atomic_load_n(&h->best_seq, __ATOMIC_ACQUIRE);
+        if ((seq1 & 1) || seq1 == seen[i]) continue;
+        
+        unpack_chromosome(scratch, sh->bests + i * sh->slot_bytes, sh->robot_count, sh->max_survivors_per_robot);
+        int gen = h->best_generation;
+        int fidelity = h->best_fidelity;
+        
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&h->best_seq, __ATOMIC_RELAXED) != seq1) continue;
+        
+        seen[i] = seq1;
+        scratch->fidelity = fidelity;
+        ga_publish_best(scratch, gen);
+    }
+}
+
+void evolve_islands(int generations, Chromosome pop[], int pop_size,
+                    int robot_count, double mutation_rate, int elitism_pct,
+                    const Node robot_starts[], const Survivor survivors[],
+                    int survivor_count, const Config *cfg, Rng *rng) {
+    if (!pop || pop_size <= 0 || robot_count <= 0 || !cfg || !rng) return;
+    
+    int island_count = cfg->island_count > 0 ? cfg->island_count : cpuset_available();
+    if (island_count > pop_size / 2) island_count = pop_size / 2;
+    if (island_count < 2) {
+        printf("Island model needs at least 2 islands; running generational GA\n");
+        evolve_loop(generations, pop, pop_size, robot_count, mutation_rate, elitism_pct,
+                    robot_starts, survivors, survivor_count, cfg, rng);
+        return;
+    }
+    
+    int max_surv = cfg->max_survivors_per_robot;
+    IslandShared sh = {0};
+    sh.island_count = island_count;
+    sh.robot_count = robot_count;
+    sh.max_survivors_per_robot = max_surv;
+    sh.migration_size = cfg->migration_size;
+    sh.slot_bytes = packed_size(robot_count, max_surv);
+    
+    sh.result_offset = malloc((island_count + 1) * sizeof(int));
+    if (!sh.result_offset) return;
+    for (int i = 0; i <= island_count; i++) {
+        sh.result_offset[i] = (int)((long)pop_size * i / island_count);
+    }
+    
+    // One anonymous shared mapping, inherited by every island at fork
+    size_t headers_bytes = (island_count * sizeof(IslandHeader) + 7) & ~(size_t)7;
+    size_t mailbox_bytes = (size_t)island_count * sh.migration_size * sh.slot_bytes;
+    size_t bests_bytes = (size_t)island_count * sh.slot_bytes;
+    size_t results_bytes = (size_t)pop_size * sh.slot_bytes;
+    sh.total_bytes = headers_bytes + mailbox_bytes + bests_bytes + results_bytes;
+    sh.base = mmap(NULL, sh.total_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (sh.base == MAP_FAILED) {
+        perror("mmap (islands)");
+        free(sh.result_offset);
+        return;
+    }
+    memset(sh.base, 0, headers_bytes);
+    sh.headers = (IslandHeader *)sh.base;
+    sh.mailboxes = (char *)sh.base + headers_bytes;
+    sh.bests = sh.mailboxes + mailbox_bytes;
+    sh.results = sh.bests + bests_bytes;
+    
+    printf("Starting island evolution: %d islands, %d generations, migrate %d every %d (%s)\n",
+           island_count, generations, sh.migration_size, cfg->migration_interval,
+           cfg->migration_topology == MIGRATION_RANDOM ? "random" : "ring");
+    
+    pid_t *pids = calloc(island_count, sizeof(pid_t));
+    unsigned int *best_seen = calloc(island_count, sizeof(unsigned int));
+    Chromosome *scratch = allocate_population(1, robot_count, max_surv);
+    if (!pids || !best_seen || !scratch) {
+        free(pids);
+        free(best_seen);
+        if (scratch) free_population(scratch, 1, robot_count);
+        munmap(sh.base, sh.total_bytes);
+        free(sh.result_offset);
+        return;
+    }
+    
+    // Deadline is shared: every island measures it from the same instant,
+    // taken before the cost table is built so setup counts against it
+    StopCriteria stop;
+    stop_criteria_init(&stop, cfg);
+    
+    // Built once here and inherited by every island
+    if ((cfg->local_search != LOCAL_SEARCH_OFF || pop[0].tour) &&
+        cost_table_init(&pop[0], robot_count, survivor_count, cfg) != 0) {
+        fprintf(stderr, "Visit cost table unavailable: local search and tour split disabled\n");
+    }
+    
+    fflush(stdout);
+    for (int i = 0; i < island_count; i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            Rng island_rng;
+            rng_stream(&island_rng, rng, i + 1);
+            int begin = sh.result_offset[i];
+            run_island(&sh, i, generations, &stop, &pop[begin], sh.result_offset[i + 1] - begin,
+                       mutation_rate, elitism_pct, robot_starts, survivors, survivor_count,
+                       cfg, &island_rng);
+            _exit(0);
+        } else if (pid < 0) {
+            perror("fork (island)");
+        }
+        pids[i] = pid;
+    }
+    
+    // Islands publish their best plans as they improve; forward them to the
+    // best-plan slot while waiting so readers see progress mid-run
+    const struct timespec interval = {0, ISLAND_POLL_MS * 1000000L};
+    int running = 0;
+    for (int i = 0; i < island_count; i++) {
+        if (pids[i] > 0) running++;
+    }
+    while (running > 0) {
+        forward_island_bests(&sh, best_seen, scratch);
+        for (int i = 0; i < island_count; i++) {
+            if (pids[i] <= 0) continue;
+            int status;
+            pid_t done = waitpid(pids[i], &status, WNOHANG);
+            if (done == pids[i] || (done < 0 && errno != EINTR)) {
+                pids[i] = 0;
+                running--;
+            }
+        }
+        if (running > 0) nanosleep(&interval, NULL);
+    }
+    forward_island_bests(&sh, best_seen, scratch);
+    
+    // Gather every island's final subpopulation; islands that failed keep their seed
+    int last_generation = 0;
+    for (int i = 0; i < island_count; i++) {
+        IslandHeader *h = &sh.headers[i];
+        if (h->generations_run > last_generation) last_generation = h->generations_run;
+        int begin = sh.result_offset[i];
+        if (h->result_count == sh.result_offset[i + 1] - begin) {
+            for (int k = 0; k < h->result_count; k++) {
+                unpack_chromosome(&pop[begin + k], sh.results + (size_t)(begin + k) * sh.slot_bytes,
+                                  robot_count, max_surv);
+            }
+            printf("  Island %d: %d generations, best fitness = %.2f, migrants accepted = %d\n",
+                   i, h->generations_run, h->best_fitness, h->migrants_accepted);
+        } else {
+            fprintf(stderr, "  Island %d did not finish; keeping its initial individuals\n", i);
+            for (int k = begin; k < sh.result_offset[i + 1]; k++) {
+                if (!pop[k].fitness_valid) {
+                    pop[k].fitness = fitness_chromosome_cached(&pop[k], robot_count, cfg);
+                    pop[k].fitness_valid = 1;
+                }
+            }
+        }
+    }
+    sort_by_fitness(pop, pop_size);
+    ga_publish_best(&pop[0], last_generation);
+    printf("Island evolution complete. Final best fitness = %.2f\n", pop[0].fitness);
+    
+    free(pids);
+    free(best_seen);
+    free_population(scratch, 1, robot_count);
+    munmap(sh.base, sh.total_bytes);
+    free(sh.result_offset);
+}
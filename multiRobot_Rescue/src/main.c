@@ -208,6 +208,11 @@ static OptimalSolution find_optimal_astar_solution(int robot_count, int survivor
 
 
 int main(int argc, char **argv) {    
+    // Evaluator daemon for EVAL_BACKEND = tcp runs instead of a search
+    if (argc >= 3 && strcmp(argv[1], "--evaluator") == 0) {
+        return evaluator_serve(argc >= 4 ? argv[3] : "127.0.0.1", atoi(argv[2])) == 0 ? 0 : 1;
+    }
+    
     Config cfg = {0};  // initialize all fields to 0 as a safety net
     if (load_config("configfile.txt", &cfg) != 0) {
         fprintf(stderr, "Failed to load config file.\n");
@@ -225,17 +230,31 @@ int main(int argc, char **argv) {
         return 1;
     }
     
-    // Initialize random seed
-    srand(time(NULL));
+    // Initialize random streams: one for the grid, one for the GA
+    unsigned long long seed = cfg.random_seed ? cfg.random_seed : (unsigned long long)time(NULL);
+    printf("Random seed: %llu\n", seed);
+    Rng grid_rng, ga_rng;
+    rng_seed(&grid_rng, seed);
+    rng_stream(&ga_rng, &grid_rng, 1);
     
     // Generate grid content
-    generate_obstacles(&cfg);
+    generate_obstacles(&cfg, &grid_rng);
     assign_risk_from_obstacles(&cfg);
-    simulate_sensors(&cfg);
+    simulate_sensors(&cfg, &grid_rng);
     detect_survivors(&cfg);
+    if (grid_rebuild_indexes(&cfg) != 0) {
+        fprintf(stderr, "Warning: grid indexes unavailable, tracing from the cell grid\n");
+    }
+    fitness_survivors_init(&cfg);
     
     int total_survivors = count_survivors(&cfg);
     printf("Detected %d survivors in the grid.\n", total_survivors);
+    RegionStats whole = grid_box_stats((Node){0, 0, 0},
+                                       (Node){cfg.grid_x - 1, cfg.grid_y - 1, cfg.grid_z - 1}, &cfg);
+    if (whole.cells > 0) {
+        printf("Grid: %.1f%% obstacles, mean risk %.2f\n",
+               100.0 * whole.obstacles / whole.cells, (double)whole.risk / whole.cells);
+    }
 
     Chromosome *population = allocate_population(cfg.population_size, cfg.robot_count, cfg.max_survivors_per_robot);
     if (!population) {
@@ -419,13 +438,53 @@ int main(int argc, char **argv) {
         printf("  Robot %d starts at: (%d, %d, %d) [FREE CELL WITH PATH]\n",
                r, robot_starts[r].x, robot_starts[r].y, robot_starts[r].z);
     }
+    if (cfg.encoding == ENCODING_GIANT_TOUR &&
+        tour_attach(population, cfg.population_size, survivor_count) != 0) {
+        fprintf(stderr, "Giant-tour encoding unavailable, using the mission encoding\n");
+        tour_detach(population, cfg.population_size);
+    }
     seed_population(population, cfg.population_size, robot_starts,
-        cfg.robot_count, survivors, survivor_count, &cfg);
+        cfg.robot_count, survivors, survivor_count, &cfg, &ga_rng);
+
+    // Exact path lengths for rescoring the leaders; built before any engine
+    // forks so every island shares them
+    if (cfg.exact_top_k > 0 && path_service_init(robot_starts, cfg.robot_count, &cfg) != 0) {
+        fprintf(stderr, "Exact path rescoring disabled: path service unavailable\n");
+        cfg.exact_top_k = 0;
+    }
+
+    // Engines keep the best plan so far in this slot; it can be read at any
+    // time, including when a time budget cuts the run short
+    BestPlanSlot best_plan;
+    if (best_plan_init(&best_plan, cfg.robot_count, cfg.max_survivors_per_robot) == 0) {
+        ga_set_best_plan_slot(&best_plan);
+    }
 
     // Run genetic algorithm evolution
-    evolve_loop(cfg.generations, population, cfg.population_size, cfg.robot_count,
-                cfg.mutation_rate, cfg.elitism_percent,
-                robot_starts, survivors, survivor_count, &cfg);
+    double evolve_start = monotonic_seconds();
+    if (cfg.ga_engine == GA_ENGINE_ISLAND) {
+        evolve_islands(cfg.generations, population, cfg.population_size, cfg.robot_count,
+                       cfg.mutation_rate, cfg.elitism_percent,
+                       robot_starts, survivors, survivor_count, &cfg, &ga_rng);
+    } else if (cfg.ga_engine == GA_ENGINE_STEADY) {
+        evolve_steady_state(cfg.generations, population, cfg.population_size, cfg.robot_count,
+                            cfg.mutation_rate, cfg.elitism_percent,
+                            robot_starts, survivors, survivor_count, &cfg, &ga_rng);
+    } else {
+        evolve_loop(cfg.generations, population, cfg.population_size, cfg.robot_count,
+                    cfg.mutation_rate, cfg.elitism_percent,
+                    robot_starts, survivors, survivor_count, &cfg, &ga_rng);
+    }
+
+    ga_set_best_plan_slot(NULL);
+    int best_generation = 0;
+    double best_found_at = 0.0;
+    if (best_plan_read(&best_plan, &population[0], &best_generation, &best_found_at)) {
+        printf("Best plan: fitness %.2f from generation %d, ready after %.0f ms\n",
+               population[0].fitness, best_generation,
+               (best_found_at - evolve_start) * 1000.0);
+    }
+    best_plan_free(&best_plan);
 
     printf("\n");
     
@@ -678,6 +737,7 @@ int main(int argc, char **argv) {
 
     free_population(population, cfg.population_size, cfg.robot_count);
     free(survivors);  
+    path_service_free();
     free_grid(&cfg);
     
     
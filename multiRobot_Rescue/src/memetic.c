@@ -0,0 +1,195 @@
+#include "all_headers.h"
+
+// Per-thread scratch: assigned set and best move per robot pair
+typedef struct {
+    unsigned int *assigned;     // == epoch when the sid is in some mission
+    unsigned int epoch;
+    int survivor_capacity;
+    double *pair_gain;          // [a * R + b]: best gain of moving a survivor from a to b
+    int *pair_index;            // position in mission a achieving pair_gain
+    int robot_capacity;
+} SearchScratch;
+
+static __thread SearchScratch search_scratch = {0};
+
+void local_search_release_thread_scratch(void) {
+    free(search_scratch.assigned);
+    free(search_scratch.pair_gain);
+    free(search_scratch.pair_index);
+    search_scratch = (SearchScratch){0};
+}
+
+static int search_scratch_reserve(SearchScratch *ss, int survivor_count, int robot_count) {
+    if (survivor_count > ss->survivor_capacity) {
+        unsigned int *assigned = realloc(ss->assigned, survivor_count * sizeof(unsigned int));
+        if (!assigned) return -1;
+        memset(assigned, 0, survivor_count * sizeof(unsigned int));
+        ss->assigned = assigned;
+        ss->survivor_capacity = survivor_count;
+        ss->epoch = 0;
+    }
+    if (robot_count > ss->robot_capacity) {
+        size_t pairs = (size_t)robot_count * robot_count;
+        double *gain = realloc(ss->pair_gain, pairs * sizeof(double));
+        if (!gain) return -1;
+        ss->pair_gain = gain;
+        int *index = realloc(ss->pair_index, pairs * sizeof(int));
+        if (!index) return -1;
+        ss->pair_index = index;
+        ss->robot_capacity = robot_count;
+    }
+    if (++ss->epoch == 0) {
+        memset(ss->assigned, 0, ss->survivor_capacity * sizeof(unsigned int));
+        ss->epoch = 1;
+    }
+    return 0;
+}
+
+static void mark_dirty(Chromosome *c, int r) {
+    if (c->scores) c->scores[r].dirty = 1;
+}
+
+typedef enum { MOVE_NONE, MOVE_RELOCATE, MOVE_EXCHANGE, MOVE_SWAP_IN } MoveKind;
+
+int local_search(Chromosome *c, int robot_count, const Config *cfg) {
+    const CostTable *ct = cost_table_get();
+    if (!c || !cost_table_matches(ct, c, robot_count)) return 0;
+    
+    int n = ct->survivor_count;
+    int capacity = cfg->max_survivors_per_robot;
+    SearchScratch *ss = &search_scratch;
+    if (search_scratch_reserve(ss, n, robot_count) != 0) return 0;
+    
+    // The table only describes sids below n; duplicates would make the
+    // deltas inexact, so such chromosomes are left to the GA
+    for (int r = 0; r < robot_count; r++) {
+        const RobotMission *m = &c->missions[r];
+        for (int s = 0; s < m->survivor_count; s++) {
+            int sid = m->survivor_sequence[s];
+            if (sid < 0 || sid >= n || ss->assigned[sid] == ss->epoch) return 0;
+            ss->assigned[sid] = ss->epoch;
+        }
+    }
+    
+    int max_moves = cfg->local_search_moves;
+    int moves = 0;
+    
+    while (max_moves <= 0 || moves < max_moves) {
+        // Best single-survivor transfer for every ordered robot pair
+        for (int a = 0; a < robot_count; a++) {
+            const RobotMission *m = &c->missions[a];
+            const double *row_a = &ct->value[(size_t)a * n];
+            for (int b = 0; b < robot_count; b++) {
+                double best = -INFINITY;
+                int best_idx = -1;
+                if (b != a) {
+                    const double *row_b = &ct->value[(size_t)b * n];
+                    for (int s = 0; s < m->survivor_count; s++) {
+                        int sid = m->survivor_sequence[s];
+                        double gain = row_b[sid] - row_a[sid];
+                        if (gain > best) {
+                            best = gain;
+                            best_idx = s;
+                        }
+                    }
+                }
+                ss->pair_gain[a * robot_count + b] = best;
+                ss->pair_index[a * robot_count + b] = best_idx;
+            }
+        }
+        
+        MoveKind kind = MOVE_NONE;
+        double best_gain = 1e-9;
+        int move_a = -1, move_b = -1, move_s = -1, move_t = -1;
+        
+        for (int a = 0; a < robot_count; a++) {
+            int count_a = c->missions[a].survivor_count;
+            for (int b = 0; b < robot_count; b++) {
+                if (b == a) continue;
+                double g_ab = ss->pair_gain[a * robot_count + b];
+                
+                // Relocate: a keeps at least one survivor, b has room
+                if (count_a > 1 && c->missions[b].survivor_count < capacity && g_ab > best_gain) {
+                    kind = MOVE_RELOCATE;
+                    best_gain = g_ab;
+                    move_a = a;
+                    move_b = b;
+                    move_s = ss->pair_index[a * robot_count + b];
+                }
+                
+                // Exchange: the deltas of the two transfers simply add up
+                if (b > a && count_a > 0 && c->missions[b].survivor_count > 0) {
+                    double g = g_ab + ss->pair_gain[b * robot_count + a];
+                    if (g > best_gain) {
+                        kind = MOVE_EXCHANGE;
+                        best_gain = g;
+                        move_a = a;
+                        move_b = b;
+                        move_s = ss->pair_index[a * robot_count + b];
+                        move_t = ss->pair_index[b * robot_count + a];
+                    }
+                }
+            }
+            
+            // Swap-in: best unassigned survivor replaces a's weakest visit
+            if (count_a > 0) {
+                const double *row_a = &ct->value[(size_t)a * n];
+                const int *ranked = &ct->ranked[(size_t)a * n];
+                int worst = 0;
+                for (int s = 1; s < count_a; s++) {
+                    if (row_a[c->missions[a].survivor_sequence[s]] <
+                        row_a[c->missions[a].survivor_sequence[worst]]) {
+                        worst = s;
+                    }
+                }
+                for (int k = 0; k < n; k++) {
+                    int sid = ranked[k];
+                    if (ss->assigned[sid] == ss->epoch) continue;
+                    double g = row_a[sid] - row_a[c->missions[a].survivor_sequence[worst]];
+                    if (g > best_gain) {
+                        kind = MOVE_SWAP_IN;
+                        best_gain = g;
+                        move_a = a;
+                        move_s = worst;
+                        move_t = sid;
+                    }
+                    break;
+                }
+            }
+        }
+        
+        if (kind == MOVE_NONE) break;
+        
+        RobotMission *ma = &c->missions[move_a];
+        if (kind == MOVE_RELOCATE) {
+            RobotMission *mb = &c->missions[move_b];
+            int sid = ma->survivor_sequence[move_s];
+            for (int s = move_s; s < ma->survivor_count - 1; s++) {
+                ma->survivor_sequence[s] = ma->survivor_sequence[s + 1];
+            }
+            ma->survivor_sequence[--ma->survivor_count] = -1;
+            mb->survivor_sequence[mb->survivor_count++] = sid;
+            mark_dirty(c, move_b);
+        } else if (kind == MOVE_EXCHANGE) {
+            RobotMission *mb = &c->missions[move_b];
+            int temp = ma->survivor_sequence[move_s];
+            ma->survivor_sequence[move_s] = mb->survivor_sequence[move_t];
+            mb->survivor_sequence[move_t] = temp;
+            mark_dirty(c, move_b);
+        } else {
+            ss->assigned[ma->survivor_sequence[move_s]] = 0;
+            ss->assigned[move_t] = ss->epoch;
+            ma->survivor_sequence[move_s] = move_t;
+        }
+        mark_dirty(c, move_a);
+        moves++;
+    }
+    
+    if (moves > 0) {
+        // Keep a giant-tour genotype in step with the improved missions
+        if (c->tour) tour_from_missions(c, robot_count);
+        c->fitness = 0.0;
+        c->fitness_valid = 0;
+    }
+    return moves;
+}
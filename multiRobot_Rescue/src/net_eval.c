@@ -0,0 +1,846 @@
+#include "all_headers.h"
+
+#define NET_MAGIC 0x47414556u     // "GAEV"
+#define NET_VERSION 1
+// Chromosomes per batch message at most
+#define NET_MAX_BATCH 256
+// Largest batch or result message either side accepts, whatever the scenario
+#define NET_MAX_MESSAGE (1u << 30)
+// Largest grid a scenario may carry, in cells (one byte each)
+#define NET_MAX_GRID_CELLS (1u << 26)
+// Seconds to connect and hand over the scenario
+#define NET_CONNECT_SECONDS 5
+// An evaluator with batches in flight that answers nothing for this long is dropped
+#define NET_TIMEOUT_SECONDS 30.0
+// A dropped evaluator is tried again after this long
+#define NET_RETRY_SECONDS 10.0
+// Survivor flag next to the voxel bits in a scenario cell byte
+#define CELL_SURVIVOR 0x8
+
+enum {
+    NET_SCENARIO = 1,    // master -> evaluator, once per connection
+    NET_READY,           // evaluator -> master, scenario accepted
+    NET_BATCH,           // master -> evaluator
+    NET_RESULT           // evaluator -> master, one per batch, in order
+};
+
+typedef struct {
+    uint32_t type;
+    uint32_t length;     // payload bytes after the header
+} MsgHeader;
+
+// Growable byte buffer; off is how much has been sent or parsed
+typedef struct {
+    char *data;
+    size_t len;
+    size_t cap;
+    size_t off;
+    int failed;          // an allocation failed, contents are incomplete
+} ByteBuf;
+
+static int buf_reserve(ByteBuf *b, size_t extra) {
+    if (b->len + extra <= b->cap) return 0;
+    size_t cap = b->cap ? b->cap : 4096;
+    while (cap < b->len + extra) cap *= 2;
+    char *grown = realloc(b->data, cap);
+    if (!grown) {
+        b->failed = 1;
+        return -1;
+    }
+    b->data = grown;
+    b->cap = cap;
+    return 0;
+}
+
+static void buf_put(ByteBuf *b, const void *p, size_t n) {
+    if (b->failed || buf_reserve(b, n) != 0) return;
+    memcpy(b->data + b->len, p, n);
+    b->len += n;
+}
+
+static void put_i32(ByteBuf *b, int32_t v) { buf_put(b, &v, sizeof(v)); }
+static void put_f64(ByteBuf *b, double v) { buf_put(b, &v, sizeof(v)); }
+
+// Drops the bytes before off
+static void buf_compact(ByteBuf *b) {
+    if (b->off == 0) return;
+    memmove(b->data, b->data + b->off, b->len - b->off);
+    b->len -= b->off;
+    b->off = 0;
+}
+
+static void buf_free(ByteBuf *b) {
+    free(b->data);
+    memset(b, 0, sizeof(*b));
+}
+
+// Starts a message in b; msg_end fills in its length
+static size_t msg_begin(ByteBuf *b, uint32_t type) {
+    size_t start = b->len;
+    MsgHeader h = {type, 0};
+    buf_put(b, &h, sizeof(h));
+    return start;
+}
+
+static void msg_end(ByteBuf *b, size_t start) {
+    if (b->failed) return;
+    uint32_t length = (uint32_t)(b->len - start - sizeof(MsgHeader));
+    memcpy(b->data + start + offsetof(MsgHeader, length), &length, sizeof(length));
+}
+
+// Bounds-checked reads from a received payload
+typedef struct {
+    const char *p;
+    const char *end;
+    int failed;
+} Reader;
+
+static void get(Reader *r, void *out, size_t n) {
+    if (r->failed || (size_t)(r->end - r->p) < n) {
+        r->failed = 1;
+        memset(out, 0, n);
+        return;
+    }
+    memcpy(out, r->p, n);
+    r->p += n;
+}
+
+static int32_t get_i32(Reader *r) {
+    int32_t v;
+    get(r, &v, sizeof(v));
+    return v;
+}
+
+static double get_f64(Reader *r) {
+    double v;
+    get(r, &v, sizeof(v));
+    return v;
+}
+
+static int write_full(int fd, const void *p, size_t n) {
+    const char *c = p;
+    while (n > 0) {
+        ssize_t w = send(fd, c, n, MSG_NOSIGNAL);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        c += w;
+        n -= (size_t)w;
+    }
+    return 0;
+}
+
+static int read_full(int fd, void *p, size_t n) {
+    char *c = p;
+    while (n > 0) {
+        ssize_t r = recv(fd, c, n, 0);
+        if (r == 0) return -1;
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        c += r;
+        n -= (size_t)r;
+    }
+    return 0;
+}
+
+// Largest payloads the scenario allows: a full batch and its result
+static size_t batch_limit(int robot_count, int max_surv) {
+    size_t item = (size_t)robot_count * (6 * sizeof(int32_t) + 2 * sizeof(double) +
+                                         (size_t)max_surv * sizeof(int32_t));
+    return 2 * sizeof(int32_t) + NET_MAX_BATCH * item;
+}
+
+static size_t result_limit(int robot_count, int batch_size) {
+    size_t item = sizeof(double) + (size_t)robot_count * (2 * sizeof(double) + sizeof(int32_t));
+    return 2 * sizeof(int32_t) + (size_t)batch_size * item;
+}
+
+// Blocking read of one whole message of at most max_length payload bytes;
+// body receives the payload
+static int read_message(int fd, uint32_t *type, ByteBuf *body, size_t max_length) {
+    MsgHeader h;
+    if (read_full(fd, &h, sizeof(h)) != 0 || h.length > max_length) return -1;
+    body->len = 0;
+    body->off = 0;
+    if (buf_reserve(body, h.length) != 0 || read_full(fd, body->data, h.length) != 0) return -1;
+    body->len = h.length;
+    *type = h.type;
+    return 0;
+}
+
+static void set_nodelay(int fd) {
+    int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
+// Listening socket on addr:port (port 0 = any free port); -1 on failure
+static int listen_on(uint32_t addr, int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("socket (evaluator)");
+        return -1;
+    }
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    
+    struct sockaddr_in sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sin_family = AF_INET;
+    sa.sin_addr.s_addr = htonl(addr);
+    sa.sin_port = htons((uint16_t)port);
+    if (bind(fd, (struct sockaddr *)&sa, sizeof(sa)) != 0 || listen(fd, 16) != 0) {
+        perror("bind (evaluator)");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// ---------------------------------------------------------------------------
+// Evaluator daemon
+// ---------------------------------------------------------------------------
+
+// Serves one master: scenario first, then batches until it hangs up
+static void serve_connection(int fd) {
+    ByteBuf msg = {0};
+    ByteBuf reply = {0};
+    Node *positions = NULL;
+    int *counts = NULL;
+    int *sequences = NULL;
+    int *was_dirty = NULL;
+    MissionScore *scores = NULL;
+    Config cfg;
+    uint32_t type;
+    
+    // A peer gets NET_CONNECT_SECONDS to hand over a scenario of bounded size
+    size_t scenario_limit = 3 * sizeof(int32_t) + sizeof(Config) + 2 * sizeof(int32_t) + NET_MAX_GRID_CELLS;
+    struct timeval timeout = {NET_CONNECT_SECONDS, 0};
+    set_nodelay(fd);
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if (read_message(fd, &type, &msg, scenario_limit) != 0 || type != NET_SCENARIO) goto done;
+    
+    Reader r = {msg.data, msg.data + msg.len, 0};
+    uint32_t magic = (uint32_t)get_i32(&r);
+    int version = get_i32(&r);
+    int config_size = get_i32(&r);
+    if (magic != NET_MAGIC || version != NET_VERSION || config_size != (int)sizeof(Config)) {
+        fprintf(stderr, "Evaluator: scenario from an incompatible build, closing\n");
+        goto done;
+    }
+    get(&r, &cfg, sizeof(cfg));
+    int robot_count = get_i32(&r);
+    int max_surv = get_i32(&r);
+    size_t cells = (size_t)cfg.grid_x * cfg.grid_y * cfg.grid_z;
+    if (r.failed || cfg.grid_x <= 0 || cfg.grid_y <= 0 || cfg.grid_z <= 0 ||
+        robot_count <= 0 || max_surv <= 0 || (size_t)(r.end - r.p) != cells ||
+        robot_count > (int)(NET_MAX_MESSAGE >> 16) || max_surv > (int)(NET_MAX_MESSAGE >> 16) ||
+        batch_limit(robot_count, max_surv) > NET_MAX_MESSAGE) {
+        fprintf(stderr, "Evaluator: malformed scenario, closing\n");
+        goto done;
+    }
+    
+    // The grid arrives as one byte per cell; rebuild what the kernel reads
+    if (allocate_grid(&cfg) != 0) goto done;
+    const unsigned char *cell = (const unsigned char *)r.p;
+    for (int z = 0; z < cfg.grid_z; z++) {
+        for (int y = 0; y < cfg.grid_y; y++) {
+            for (int x = 0; x < cfg.grid_x; x++, cell++) {
+                building[z][y][x].obstacle = *cell & VOXEL_OBSTACLE;
+                building[z][y][x].risk = (*cell >> VOXEL_RISK_SHIFT) & 0x3;
+                building[z][y][x].survivor = (*cell & CELL_SURVIVOR) != 0;
+            }
+        }
+    }
+    grid_rebuild_indexes(&cfg);
+    fitness_survivors_init(&cfg);
+    
+    positions = malloc(robot_count * sizeof(Node));
+    counts = malloc(robot_count * sizeof(int));
+    sequences = malloc((size_t)robot_count * max_surv * sizeof(int));
+    was_dirty = malloc(robot_count * sizeof(int));
+    scores = malloc(robot_count * sizeof(MissionScore));
+    if (!positions || !counts || !sequences || !was_dirty || !scores) goto done;
+    
+    size_t start = msg_begin(&reply, NET_READY);
+    put_i32(&reply, (int32_t)NET_MAGIC);
+    msg_end(&reply, start);
+    if (reply.failed || write_full(fd, reply.data, reply.len) != 0) goto done;
+    
+    // Masters may sit idle between generations; batches have no deadline
+    timeout.tv_sec = 0;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    
+    ChromosomeView view = {positions, counts, sequences, max_surv};
+    size_t max_batch = batch_limit(robot_count, max_surv);
+    while (read_message(fd, &type, &msg, max_batch) == 0 && type == NET_BATCH) {
+        r = (Reader){msg.data, msg.data + msg.len, 0};
+        int batch_id = get_i32(&r);
+        int n = get_i32(&r);
+        if (n < 0 || n > NET_MAX_BATCH) r.failed = 1;
+        
+        reply.len = 0;
+        start = msg_begin(&reply, NET_RESULT);
+        put_i32(&reply, batch_id);
+        put_i32(&reply, n);
+        for (int i = 0; i < n && !r.failed; i++) {
+            for (int k = 0; k < robot_count; k++) {
+                positions[k].x = get_i32(&r);
+                positions[k].y = get_i32(&r);
+                positions[k].z = get_i32(&r);
+                counts[k] = get_i32(&r);
+                was_dirty[k] = get_i32(&r);
+                if (counts[k] < 0 || counts[k] > max_surv) r.failed = 1;
+                if (was_dirty[k]) {
+                    scores[k] = (MissionScore){0.0, 0.0, 0, 1};
+                } else {
+                    scores[k].length = get_f64(&r);
+                    scores[k].risk = get_f64(&r);
+                    scores[k].valid_paths = get_i32(&r);
+                    scores[k].dirty = 0;
+                }
+                for (int s = 0; s < counts[k] && !r.failed; s++) {
+                    sequences[(size_t)k * max_surv + s] = get_i32(&r);
+                }
+                if (r.failed) break;
+            }
+            if (r.failed) break;
+            
+            put_f64(&reply, fitness_view_cached(&view, scores, robot_count, &cfg));
+            for (int k = 0; k < robot_count; k++) {
+                if (!was_dirty[k]) continue;
+                put_f64(&reply, scores[k].length);
+                put_f64(&reply, scores[k].risk);
+                put_i32(&reply, scores[k].valid_paths);
+            }
+        }
+        if (r.failed) {
+            fprintf(stderr, "Evaluator: malformed batch, closing\n");
+            break;
+        }
+        msg_end(&reply, start);
+        if (reply.failed || write_full(fd, reply.data, reply.len) != 0) break;
+    }
+
+done:
+    free(positions);
+    free(counts);
+    free(sequences);
+    free(was_dirty);
+    free(scores);
+    buf_free(&msg);
+    buf_free(&reply);
+    close(fd);
+}
+
+// Accepts masters on listen_fd, one forked process per connection
+static void serve_listener(int listen_fd) {
+    signal(SIGCHLD, SIG_IGN);  // connection processes are reaped by the kernel
+    for (;;) {
+        int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            perror("accept (evaluator)");
+            return;
+        }
+        pid_t pid = fork();
+        if (pid == 0) {
+            prctl(PR_SET_PDEATHSIG, SIGKILL);  // even a hung one leaves with its daemon
+            close(listen_fd);
+            serve_connection(fd);
+            _exit(0);
+        }
+        if (pid < 0) perror("fork (evaluator)");
+        close(fd);
+    }
+}
+
+int evaluator_serve(const char *bind_addr, int port) {
+    struct in_addr addr;
+    if (port <= 0 || port > 65535) {
+        fprintf(stderr, "Evaluator: invalid port %d\n", port);
+        return -1;
+    }
+    if (inet_pton(AF_INET, bind_addr, &addr) != 1) {
+        fprintf(stderr, "Evaluator: invalid bind address '%s'\n", bind_addr);
+        return -1;
+    }
+    int fd = listen_on(ntohl(addr.s_addr), port);
+    if (fd < 0) return -1;
+    printf("Evaluator listening on %s:%d\n", bind_addr, port);
+    fflush(stdout);
+    serve_listener(fd);
+    close(fd);
+    return -1;
+}
+
+// ---------------------------------------------------------------------------
+// Master side
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    char host[64];
+    int port;
+    int fd;                       // -1 = not connected
+    pid_t local_pid;              // daemon forked by net_eval_start, 0 = remote
+    ByteBuf out;                  // bytes queued for the socket
+    ByteBuf in;                   // bytes received and not yet parsed
+    int inflight[NET_WINDOW];     // batch ids in send order
+    int inflight_count;
+    double last_progress;         // last result, or first send after being idle
+    double retry_at;              // when a dropped evaluator may reconnect
+} Evaluator;
+
+static Evaluator *evaluators = NULL;
+static int evaluator_count = 0;
+static ByteBuf scenario;          // NET_SCENARIO, sent again on every reconnect
+static int net_max_surv = 0;
+
+// Connect with a deadline so an unreachable host cannot stall the master
+static int connect_within(int fd, const struct sockaddr *addr, socklen_t len, int seconds) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    int rc = connect(fd, addr, len);
+    if (rc != 0 && errno == EINPROGRESS) {
+        struct pollfd p = {fd, POLLOUT, 0};
+        int err = 0;
+        socklen_t err_len = sizeof(err);
+        rc = -1;
+        if (poll(&p, 1, seconds * 1000) == 1 &&
+            getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &err_len) == 0 && err == 0) {
+            rc = 0;
+        }
+    }
+    fcntl(fd, F_SETFL, flags);
+    return rc;
+}
+
+// Connects to e and hands over the scenario; 0 once the evaluator is ready
+static int evaluator_connect(Evaluator *e) {
+    struct addrinfo hints;
+    struct addrinfo *res = NULL;
+    char port[16];
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    snprintf(port, sizeof(port), "%d", e->port);
+    if (getaddrinfo(e->host, port, &hints, &res) != 0) return -1;
+    
+    int fd = -1;
+    for (struct addrinfo *ai = res; ai && fd < 0; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd >= 0 && connect_within(fd, ai->ai_addr, ai->ai_addrlen, NET_CONNECT_SECONDS) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(res);
+    if (fd < 0) return -1;
+    
+    set_nodelay(fd);
+    struct timeval timeout = {NET_CONNECT_SECONDS, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    
+    ByteBuf reply = {0};
+    uint32_t type = 0;
+    int ready = write_full(fd, scenario.data, scenario.len) == 0 &&
+                read_message(fd, &type, &reply, sizeof(uint32_t)) == 0 && type == NET_READY &&
+                reply.len >= sizeof(uint32_t) && *(uint32_t *)reply.data == NET_MAGIC;
+    buf_free(&reply);
+    if (!ready) {
+        close(fd);
+        return -1;
+    }
+    
+    // Batches are exchanged without blocking
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    e->fd = fd;
+    e->out.len = e->out.off = 0;
+    e->in.len = e->in.off = 0;
+    e->inflight_count = 0;
+    return 0;
+}
+
+// Forks a daemon listening on a free loopback port; its pid, or -1
+static pid_t spawn_local_evaluator(int *port) {
+    int fd = listen_on(INADDR_LOOPBACK, 0);
+    if (fd < 0) return -1;
+    struct sockaddr_in sa;
+    socklen_t len = sizeof(sa);
+    if (getsockname(fd, (struct sockaddr *)&sa, &len) != 0) {
+        close(fd);
+        return -1;
+    }
+    *port = ntohs(sa.sin_port);
+    
+    fflush(stdout);
+    fflush(stderr);
+    pid_t pid = fork();
+    if (pid == 0) {
+        prctl(PR_SET_PDEATHSIG, SIGTERM);  // leave with the master
+        serve_listener(fd);
+        _exit(1);
+    }
+    close(fd);
+    if (pid < 0) perror("fork (local evaluator)");
+    return pid;
+}
+
+static int add_evaluator(const char *host, int port, pid_t local_pid) {
+    Evaluator *grown = realloc(evaluators, (evaluator_count + 1) * sizeof(Evaluator));
+    if (!grown) return -1;
+    evaluators = grown;
+    Evaluator *e = &evaluators[evaluator_count++];
+    memset(e, 0, sizeof(*e));
+    snprintf(e->host, sizeof(e->host), "%s", host);
+    e->port = port;
+    e->fd = -1;
+    e->local_pid = local_pid;
+    return 0;
+}
+
+static int build_scenario(const Config *cfg, int robot_count) {
+    size_t start = msg_begin(&scenario, NET_SCENARIO);
+    put_i32(&scenario, (int32_t)NET_MAGIC);
+    put_i32(&scenario, NET_VERSION);
+    put_i32(&scenario, (int32_t)sizeof(Config));
+    buf_put(&scenario, cfg, sizeof(Config));
+    put_i32(&scenario, robot_count);
+    put_i32(&scenario, net_max_surv);
+    for (int z = 0; z < cfg->grid_z; z++) {
+        for (int y = 0; y < cfg->grid_y; y++) {
+            for (int x = 0; x < cfg->grid_x; x++) {
+                const Cell *c = &building[z][y][x];
+                unsigned char b = (c->obstacle ? VOXEL_OBSTACLE : 0) |
+                                  (unsigned char)((c->risk & 0x3) << VOXEL_RISK_SHIFT) |
+                                  (c->survivor ? CELL_SURVIVOR : 0);
+                buf_put(&scenario, &b, 1);
+            }
+        }
+    }
+    msg_end(&scenario, start);
+    return scenario.failed ? -1 : 0;
+}
+
+int net_eval_start(const Config *cfg, int robot_count) {
+    if (!cfg || !building || evaluators) return 0;
+    net_max_surv = cfg->max_survivors_per_robot > 0 ? cfg->max_survivors_per_robot : 100;
+    if (build_scenario(cfg, robot_count) != 0) {
+        fprintf(stderr, "Failed to encode the scenario for evaluators\n");
+        return 0;
+    }
+    
+    for (int i = 0; i < cfg->evaluator_spawn_local; i++) {
+        int port = 0;
+        pid_t pid = spawn_local_evaluator(&port);
+        if (pid > 0) add_evaluator("127.0.0.1", port, pid);
+    }
+    
+    // EVALUATOR_HOSTS: host:port entries separated by commas
+    char hosts[sizeof(cfg->evaluator_hosts)];
+    snprintf(hosts, sizeof(hosts), "%s", cfg->evaluator_hosts);
+    char *save = NULL;
+    for (char *entry = strtok_r(hosts, ",", &save); entry; entry = strtok_r(NULL, ",", &save)) {
+        char *colon = strrchr(entry, ':');
+        int port = colon ? atoi(colon + 1) : 0;
+        if (!colon || port <= 0 || port > 65535) {
+            fprintf(stderr, "Warning: ignoring evaluator '%s' (expected host:port)\n", entry);
+            continue;
+        }
+        *colon = '\0';
+        add_evaluator(entry, port, 0);
+    }
+    
+    int ready = 0;
+    for (int i = 0; i < evaluator_count; i++) {
+        Evaluator *e = &evaluators[i];
+        if (evaluator_connect(e) == 0) {
+            ready++;
+        } else {
+            fprintf(stderr, "Evaluator %s:%d unavailable\n", e->host, e->port);
+            e->retry_at = monotonic_seconds() + NET_RETRY_SECONDS;
+        }
+    }
+    return ready;
+}
+
+void net_eval_stop(void) {
+    for (int i = 0; i < evaluator_count; i++) {
+        Evaluator *e = &evaluators[i];
+        if (e->fd >= 0) close(e->fd);
+        buf_free(&e->out);
+        buf_free(&e->in);
+        if (e->local_pid > 0) {
+            kill(e->local_pid, SIGTERM);
+            while (waitpid(e->local_pid, NULL, 0) < 0 && errno == EINTR) {
+            }
+        }
+    }
+    free(evaluators);
+    evaluators = NULL;
+    evaluator_count = 0;
+    buf_free(&scenario);
+}
+
+int net_eval_active(void) {
+    return evaluator_count > 0;
+}
+
+// One net_eval_run call: batches of batch_size consecutive indices, and a
+// FIFO of batches waiting for an evaluator
+typedef struct {
+    Chromosome *pop;
+    const int *indices;
+    int count;
+    int robot_count;
+    int batch_size;
+    int batches;
+    char *done;           // per batch
+    int *queue;
+    int queue_head;
+    int queue_count;
+} NetRun;
+
+static void queue_batch(NetRun *run, int b) {
+    run->queue[(run->queue_head + run->queue_count) % run->batches] = b;
+    run->queue_count++;
+}
+
+static int next_batch(NetRun *run) {
+    int b = run->queue[run->queue_head];
+    run->queue_head = (run->queue_head + 1) % run->batches;
+    run->queue_count--;
+    return b;
+}
+
+static int batch_length(const NetRun *run, int b) {
+    int first = b * run->batch_size;
+    return first + run->batch_size < run->count ? run->batch_size : run->count - first;
+}
+
+static void put_chromosome(ByteBuf *out, const Chromosome *c, int robot_count) {
+    for (int r = 0; r < robot_count; r++) {
+        const RobotMission *m = &c->missions[r];
+        const MissionScore *s = &c->scores[r];
+        int visits = m->survivor_count;
+        if (visits < 0) visits = 0;
+        if (visits > net_max_surv) visits = net_max_surv;
+        put_i32(out, m->robot_pos.x);
+        put_i32(out, m->robot_pos.y);
+        put_i32(out, m->robot_pos.z);
+        put_i32(out, visits);
+        put_i32(out, s->dirty);
+        if (!s->dirty) {
+            put_f64(out, s->length);
+            put_f64(out, s->risk);
+            put_i32(out, s->valid_paths);
+        }
+        for (int k = 0; k < visits; k++) {
+            put_i32(out, m->survivor_sequence[k]);
+        }
+    }
+}
+
+static void send_batch(Evaluator *e, NetRun *run, int b) {
+    int first = b * run->batch_size;
+    int n = batch_length(run, b);
+    
+    buf_compact(&e->out);
+    size_t start = msg_begin(&e->out, NET_BATCH);
+    put_i32(&e->out, b);
+    put_i32(&e->out, n);
+    for (int k = 0; k < n; k++) {
+        put_chromosome(&e->out, &run->pop[run->indices[first + k]], run->robot_count);
+    }
+    msg_end(&e->out, start);
+    
+    if (e->inflight_count == 0) e->last_progress = monotonic_seconds();
+    e->inflight[e->inflight_count++] = b;
+}
+
+// Writes as much queued output as the socket takes; -1 on a lost connection
+static int flush_out(Evaluator *e) {
+    if (e->out.failed) return -1;
+    while (e->out.off < e->out.len) {
+        ssize_t w = send(e->fd, e->out.data + e->out.off, e->out.len - e->out.off, MSG_NOSIGNAL);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+            return -1;
+        }
+        e->out.off += (size_t)w;
+    }
+    return 0;
+}
+
+// Stores one NET_RESULT payload; -1 if it does not match the oldest batch in flight
+// Reads the n results of a batch starting at slot first. Only writes them
+// into the chromosomes when apply is set; the dirty flags it walks by are
+// left alone until then, so a dry run and the real one read the same bytes.
+static int read_batch_results(Reader *r, NetRun *run, int first, int n, int apply) {
+    for (int k = 0; k < n; k++) {
+        Chromosome *c = &run->pop[run->indices[first + k]];
+        double fitness = get_f64(r);
+        if (apply) c->fitness = fitness;
+        for (int m = 0; m < run->robot_count; m++) {
+            if (!c->scores[m].dirty) continue;
+            double len = get_f64(r);
+            double risk = get_f64(r);
+            int valid = get_i32(r);
+            if (r->failed) return -1;
+            if (apply) c->scores[m] = (MissionScore){len, risk, valid, 0};
+        }
+    }
+    return r->failed || r->p != r->end ? -1 : 0;
+}
+
+static int take_result(Evaluator *e, NetRun *run, const char *payload, size_t length) {
+    Reader r = {payload, payload + length, 0};
+    int b = get_i32(&r);
+    int n = get_i32(&r);
+    if (r.failed || e->inflight_count == 0 || b != e->inflight[0] || n != batch_length(run, b)) return -1;
+    
+    // Validate the whole message first: a truncated or malformed result
+    // must not leave half a batch scored and the rest marked clean
+    int first = b * run->batch_size;
+    Reader check = r;
+    if (read_batch_results(&check, run, first, n, 0) != 0) return -1;
+    read_batch_results(&r, run, first, n, 1);
+    
+    run->done[b] = 1;
+    e->inflight_count--;
+    memmove(e->inflight, e->inflight + 1, e->inflight_count * sizeof(int));
+    e->last_progress = monotonic_seconds();
+    return 0;
+}
+
+// Reads what has arrived and stores complete results. Returns the number
+// of batches finished, -1 on a lost connection or a protocol error.
+static int read_results(Evaluator *e, NetRun *run) {
+    for (;;) {
+        if (buf_reserve(&e->in, 65536) != 0) return -1;
+        ssize_t got = recv(e->fd, e->in.data + e->in.len, e->in.cap - e->in.len, 0);
+        if (got == 0) return -1;
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return -1;
+        }
+        e->in.len += (size_t)got;
+    }
+    
+    int finished = 0;
+    while (e->in.len - e->in.off >= sizeof(MsgHeader)) {
+        MsgHeader h;
+        memcpy(&h, e->in.data + e->in.off, sizeof(h));
+        if (h.type != NET_RESULT || h.length > result_limit(run->robot_count, run->batch_size)) return -1;
+        if (e->in.len - e->in.off < sizeof(h) + h.length) break;
+        if (take_result(e, run, e->in.data + e->in.off + sizeof(h), h.length) != 0) return -1;
+        e->in.off += sizeof(h) + h.length;
+        finished++;
+    }
+    buf_compact(&e->in);
+    return finished;
+}
+
+// Drops e's connection and puts its batches back in the queue
+static void evaluator_lost(Evaluator *e, NetRun *run, const char *why) {
+    fprintf(stderr, "Evaluator %s:%d %s; requeueing %d batches\n", e->host, e->port, why, e->inflight_count);
+    for (int k = 0; k < e->inflight_count; k++) {
+        queue_batch(run, e->inflight[k]);
+    }
+    e->inflight_count = 0;
+    close(e->fd);
+    e->fd = -1;
+    e->retry_at = monotonic_seconds() + NET_RETRY_SECONDS;
+}
+
+int net_eval_run(Chromosome pop[], const int indices[], int count, int robot_count, int leftover[]) {
+    // Dropped evaluators get another chance once their back-off has passed
+    double now = monotonic_seconds();
+    int alive = 0;
+    for (int i = 0; i < evaluator_count; i++) {
+        Evaluator *e = &evaluators[i];
+        if (e->fd < 0 && now >= e->retry_at) {
+            if (evaluator_connect(e) == 0) {
+                printf("Evaluator %s:%d connected again\n", e->host, e->port);
+            } else {
+                e->retry_at = now + NET_RETRY_SECONDS;
+            }
+        }
+        alive += e->fd >= 0;
+    }
+    
+    // Enough batches per evaluator to keep its window full to the end
+    NetRun run = {pop, indices, count, robot_count, 0, 0, NULL, NULL, 0, 0};
+    run.batch_size = alive > 0 ? count / (alive * NET_WINDOW * 2) : count;
+    if (run.batch_size < 1) run.batch_size = 1;
+    if (run.batch_size > NET_MAX_BATCH) run.batch_size = NET_MAX_BATCH;
+    run.batches = count > 0 ? (count + run.batch_size - 1) / run.batch_size : 0;
+    run.done = calloc(run.batches > 0 ? run.batches : 1, 1);
+    run.queue = malloc((run.batches > 0 ? run.batches : 1) * sizeof(int));
+    struct pollfd *fds = malloc((evaluator_count > 0 ? evaluator_count : 1) * sizeof(struct pollfd));
+    int *polled = malloc((evaluator_count > 0 ? evaluator_count : 1) * sizeof(int));
+    
+    if (alive > 0 && run.done && run.queue && fds && polled) {
+        for (int b = 0; b < run.batches; b++) queue_batch(&run, b);
+        
+        int finished = 0;
+        while (finished < run.batches) {
+            // Top up every window; a full window is the backpressure
+            int n = 0;
+            for (int i = 0; i < evaluator_count; i++) {
+                Evaluator *e = &evaluators[i];
+                if (e->fd < 0) continue;
+                while (e->inflight_count < NET_WINDOW && run.queue_count > 0) {
+                    send_batch(e, &run, next_batch(&run));
+                }
+                if (flush_out(e) != 0) {
+                    evaluator_lost(e, &run, "failed");
+                    continue;
+                }
+                fds[n] = (struct pollfd){e->fd, POLLIN | (e->out.off < e->out.len ? POLLOUT : 0), 0};
+                polled[n++] = i;
+            }
+            if (n == 0) break;
+            
+            if (poll(fds, n, 1000) < 0 && errno != EINTR) break;
+            now = monotonic_seconds();
+            for (int k = 0; k < n; k++) {
+                Evaluator *e = &evaluators[polled[k]];
+                if ((fds[k].revents & POLLOUT) && flush_out(e) != 0) {
+                    evaluator_lost(e, &run, "failed");
+                    continue;
+                }
+                if (fds[k].revents & (POLLIN | POLLERR | POLLHUP)) {
+                    int got = read_results(e, &run);
+                    if (got < 0) {
+                        evaluator_lost(e, &run, "disconnected");
+                        continue;
+                    }
+                    finished += got;
+                }
+                if (e->inflight_count > 0 && now - e->last_progress > NET_TIMEOUT_SECONDS) {
+                    evaluator_lost(e, &run, "stopped answering");
+                }
+            }
+        }
+    }
+    
+    // What no evaluator finished goes back to the caller
+    int left = 0;
+    for (int b = 0; b < run.batches; b++) {
+        if (run.done && run.done[b]) continue;
+        int first = b * run.batch_size;
+        int n = batch_length(&run, b);
+        for (int k = 0; k < n; k++) leftover[left++] = indices[first + k];
+    }
+    free(run.done);
+    free(run.queue);
+    free(fds);
+    free(polled);
+    return left;
+}
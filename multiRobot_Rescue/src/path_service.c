@@ -0,0 +1,117 @@
+#include "all_headers.h"
+
+typedef struct {
+    Node base;
+    int *dist;          // steps from base per cell, -1 = unreachable
+} DistanceField;
+
+static DistanceField *fields = NULL;
+static int field_count = 0;
+static int field_capacity = 0;
+static pthread_mutex_t field_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static size_t cell_index(Node n, const Config *cfg) {
+    return ((size_t)n.z * cfg->grid_y + n.y) * cfg->grid_x + n.x;
+}
+
+// Breadth-first search from base; unit steps make it exact for astar()'s metric
+static int *build_field(Node base, const Config *cfg) {
+    size_t cells = (size_t)cfg->grid_x * cfg->grid_y * cfg->grid_z;
+    int *dist = malloc(cells * sizeof(int));
+    Node *queue = malloc(cells * sizeof(Node));
+    if (!dist || !queue) {
+        free(dist);
+        free(queue);
+        return NULL;
+    }
+    for (size_t i = 0; i < cells; i++) dist[i] = -1;
+    
+    static const Node offsets[] = {
+        {0, 0, 1}, {0, 0, -1}, {0, 1, 0}, {0, -1, 0}, {1, 0, 0}, {-1, 0, 0}
+    };
+    
+    size_t head = 0, tail = 0;
+    if (is_valid(base, cfg)) {
+        dist[cell_index(base, cfg)] = 0;
+        queue[tail++] = base;
+    }
+    while (head < tail) {
+        Node cur = queue[head++];
+        int next_dist = dist[cell_index(cur, cfg)] + 1;
+        for (int i = 0; i < 6; i++) {
+            Node n = {cur.x + offsets[i].x, cur.y + offsets[i].y, cur.z + offsets[i].z};
+            if (!is_valid(n, cfg)) continue;
+            size_t idx = cell_index(n, cfg);
+            if (dist[idx] >= 0) continue;
+            dist[idx] = next_dist;
+            queue[tail++] = n;
+        }
+    }
+    free(queue);
+    return dist;
+}
+
+// Caller holds field_lock
+static const int *find_field(Node base, const Config *cfg) {
+    for (int i = 0; i < field_count; i++) {
+        Node b = fields[i].base;
+        if (b.x == base.x && b.y == base.y && b.z == base.z) return fields[i].dist;
+    }
+    
+    if (field_count == field_capacity) {
+        int capacity = field_capacity ? field_capacity * 2 : 8;
+        DistanceField *grown = realloc(fields, capacity * sizeof(DistanceField));
+        if (!grown) return NULL;
+        fields = grown;
+        field_capacity = capacity;
+    }
+    int *dist = build_field(base, cfg);
+    if (!dist) return NULL;
+    fields[field_count].base = base;
+    fields[field_count].dist = dist;
+    field_count++;
+    return dist;
+}
+
+int path_service_init(const Node bases[], int base_count, const Config *cfg) {
+    if (!bases || !cfg || !building) return -1;
+    
+    int status = 0;
+    pthread_mutex_lock(&field_lock);
+    for (int i = 0; i < base_count; i++) {
+        if (!find_field(bases[i], cfg)) {
+            fprintf(stderr, "Failed to allocate path distance field\n");
+            status = -1;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&field_lock);
+    return status;
+}
+
+void path_service_free(void) {
+    pthread_mutex_lock(&field_lock);
+    for (int i = 0; i < field_count; i++) {
+        free(fields[i].dist);
+    }
+    free(fields);
+    fields = NULL;
+    field_count = 0;
+    field_capacity = 0;
+    pthread_mutex_unlock(&field_lock);
+}
+
+int path_service_length(Node base, Node goal, const Config *cfg) {
+    if (!cfg || !building) return -1;
+    if (goal.x < 0 || goal.x >= cfg->grid_x ||
+        goal.y < 0 || goal.y >= cfg->grid_y ||
+        goal.z < 0 || goal.z >= cfg->grid_z) {
+        return -1;
+    }
+    
+    pthread_mutex_lock(&field_lock);
+    const int *dist = find_field(base, cfg);
+    int steps = dist ? dist[cell_index(goal, cfg)] : -1;
+    pthread_mutex_unlock(&field_lock);
+    return steps;
+}
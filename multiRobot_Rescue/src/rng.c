@@ -0,0 +1,47 @@
+#include "all_headers.h"
+
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+void rng_seed(Rng *rng, uint64_t seed) {
+    uint64_t x = seed;
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = splitmix64(&x);
+    }
+}
+
+void rng_jump(Rng *rng) {
+    static const uint64_t jump[] = {
+        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+    };
+
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (jump[i] & (1ULL << b)) {
+                s0 ^= rng->s[0];
+                s1 ^= rng->s[1];
+                s2 ^= rng->s[2];
+                s3 ^= rng->s[3];
+            }
+            rng_next(rng);
+        }
+    }
+
+    rng->s[0] = s0;
+    rng->s[1] = s1;
+    rng->s[2] = s2;
+    rng->s[3] = s3;
+}
+
+void rng_stream(Rng *out, const Rng *base, int stream) {
+    *out = *base;
+    for (int i = 0; i < stream; i++) {
+        rng_jump(out);
+    }
+}
@@ -0,0 +1,267 @@
+#include "all_headers.h"
+
+#define TWO_PI 6.283185307179586
+
+int seed_context_init(SeedContext *ctx, const Node robot_starts[], int robot_count,
+                      const Survivor survivors[], int survivor_count, const Config *cfg) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->robot_count = robot_count;
+    ctx->survivor_count = survivor_count;
+    ctx->max_per_robot = cfg->max_survivors_per_robot;
+    ctx->robot_starts = robot_starts;
+    ctx->survivors = survivors;
+    
+    ctx->value = malloc((size_t)robot_count * survivor_count * sizeof(double));
+    if (!ctx->value) return -1;
+    
+    double sum = 0.0, sum_sq = 0.0;
+    for (int r = 0; r < robot_count; r++) {
+        for (int sid = 0; sid < survivor_count; sid++) {
+            double v = fitness_visit_value(robot_starts[r], sid, cfg);
+            ctx->value[(size_t)r * survivor_count + sid] = v;
+            sum += v;
+            sum_sq += v * v;
+        }
+    }
+    double cells = (double)robot_count * survivor_count;
+    double variance = cells > 0 ? sum_sq / cells - (sum / cells) * (sum / cells) : 0.0;
+    ctx->noise = variance > 0.0 ? 0.5 * sqrt(variance) : 1.0;
+    
+    // Sweep in the plane of the two longest grid axes
+    int extent[3] = {cfg->grid_x, cfg->grid_y, cfg->grid_z};
+    int shortest = 0;
+    for (int a = 1; a < 3; a++) {
+        if (extent[a] < extent[shortest]) shortest = a;
+    }
+    ctx->axis_u = shortest == 0 ? 1 : 0;
+    ctx->axis_v = shortest == 2 ? 1 : 2;
+    return 0;
+}
+
+void seed_context_free(SeedContext *ctx) {
+    free(ctx->value);
+    ctx->value = NULL;
+}
+
+static double node_axis(Node n, int axis) {
+    return axis == 0 ? n.x : (axis == 1 ? n.y : n.z);
+}
+
+static void clear_chromosome(Chromosome *c, const SeedContext *ctx) {
+    for (int r = 0; r < ctx->robot_count; r++) {
+        RobotMission *mission = &c->missions[r];
+        mission->robot_pos = ctx->robot_starts[r];
+        mission->survivor_count = 0;
+        for (int s = 0; s < ctx->max_per_robot; s++) {
+            mission->survivor_sequence[s] = -1;
+        }
+        if (c->scores) c->scores[r].dirty = 1;
+    }
+    c->fitness = 0.0;
+    c->fitness_valid = 0;
+}
+
+static void assign(Chromosome *c, int r, int sid) {
+    RobotMission *mission = &c->missions[r];
+    mission->survivor_sequence[mission->survivor_count++] = sid;
+}
+
+static void shuffle(int items[], int n, Rng *rng) {
+    for (int i = n - 1; i > 0; i--) {
+        int j = rng_below(rng, i + 1);
+        int temp = items[i];
+        items[i] = items[j];
+        items[j] = temp;
+    }
+}
+
+static void seed_nearest(Chromosome *c, const SeedContext *ctx, const double value[], int order[], Rng *rng) {
+    int n = ctx->survivor_count;
+    for (int i = 0; i < n; i++) order[i] = i;
+    shuffle(order, n, rng);
+    
+    for (int i = 0; i < n; i++) {
+        int sid = order[i];
+        int best = -1;
+        for (int r = 0; r < ctx->robot_count; r++) {
+            if (c->missions[r].survivor_count >= ctx->max_per_robot) continue;
+            if (best < 0 || value[r * n + sid] > value[best * n + sid]) best = r;
+        }
+        if (best < 0) break;
+        assign(c, best, sid);
+    }
+}
+
+// Sort keys for the sweep; qsort has no context argument
+static __thread const double *sweep_angle = NULL;
+
+static int compare_angle(const void *a, const void *b) {
+    double x = sweep_angle[*(const int *)a];
+    double y = sweep_angle[*(const int *)b];
+    return (x > y) - (x < y);
+}
+
+static void seed_sweep(Chromosome *c, const SeedContext *ctx, int order[], double angle[],
+                       int perturb, Rng *rng) {
+    int n = ctx->survivor_count;
+    int robots = ctx->robot_count;
+    
+    double cu = 0.0, cv = 0.0;
+    for (int r = 0; r < robots; r++) {
+        cu += node_axis(ctx->robot_starts[r], ctx->axis_u);
+        cv += node_axis(ctx->robot_starts[r], ctx->axis_v);
+    }
+    cu /= robots;
+    cv /= robots;
+    
+    // Rotating the starting ray gives a different partition per individual
+    double offset = perturb ? rng_uniform(rng) * TWO_PI : 0.0;
+    for (int sid = 0; sid < n; sid++) {
+        Node p = ctx->survivors[sid].pos;
+        double a = atan2(node_axis(p, ctx->axis_v) - cv, node_axis(p, ctx->axis_u) - cu) - offset;
+        angle[sid] = fmod(a + 2.0 * TWO_PI, TWO_PI);
+        order[sid] = sid;
+    }
+    sweep_angle = angle;
+    qsort(order, n, sizeof(int), compare_angle);
+    
+    // Robots take consecutive sectors in the same angular order
+    int *robot_order = order + n;
+    double *robot_angle = angle + n;
+    for (int r = 0; r < robots; r++) {
+        Node p = ctx->robot_starts[r];
+        double a = atan2(node_axis(p, ctx->axis_v) - cv, node_axis(p, ctx->axis_u) - cu) - offset;
+        robot_angle[r] = fmod(a + 2.0 * TWO_PI, TWO_PI);
+        robot_order[r] = r;
+    }
+    sweep_angle = robot_angle;
+    qsort(robot_order, robots, sizeof(int), compare_angle);
+    sweep_angle = NULL;
+    
+    int next = 0;
+    for (int k = 0; k < robots && next < n; k++) {
+        int share = n / robots + (k < n % robots ? 1 : 0);
+        if (share > ctx->max_per_robot) share = ctx->max_per_robot;
+        for (int s = 0; s < share && next < n; s++) {
+            assign(c, robot_order[k], order[next++]);
+        }
+    }
+    // Sectors capped by capacity spill over to robots with room
+    for (int k = 0; k < robots && next < n; k++) {
+        RobotMission *mission = &c->missions[robot_order[k]];
+        while (mission->survivor_count < ctx->max_per_robot && next < n) {
+            assign(c, robot_order[k], order[next++]);
+        }
+    }
+}
+
+static void seed_regret(Chromosome *c, const SeedContext *ctx, const double value[], int pending[]) {
+    int n = ctx->survivor_count;
+    int pending_count = n;
+    for (int i = 0; i < n; i++) pending[i] = i;
+    
+    while (pending_count > 0) {
+        int pick = -1;
+        int pick_robot = -1;
+        double pick_regret = -INFINITY;
+        
+        for (int i = 0; i < pending_count; i++) {
+            int sid = pending[i];
+            int best = -1;
+            double best_value = -INFINITY, second_value = -INFINITY;
+            for (int r = 0; r < ctx->robot_count; r++) {
+                if (c->missions[r].survivor_count >= ctx->max_per_robot) continue;
+                double v = value[r * n + sid];
+                if (v > best_value) {
+                    second_value = best_value;
+                    best_value = v;
+                    best = r;
+                } else if (v > second_value) {
+                    second_value = v;
+                }
+            }
+            if (best < 0) return;  // every robot is full
+            
+            // With a single open robot the regret is unbounded
+            double regret = second_value == -INFINITY ? INFINITY : best_value - second_value;
+            if (regret > pick_regret) {
+                pick_regret = regret;
+                pick = i;
+                pick_robot = best;
+            }
+        }
+        
+        assign(c, pick_robot, pending[pick]);
+        pending[pick] = pending[--pending_count];
+    }
+}
+
+// Every idle robot takes the survivor it values most, relative to its
+// current robot, from the busiest robot (the fitness rewards full coverage)
+static void activate_idle_robots(Chromosome *c, const SeedContext *ctx, const double value[]) {
+    int n = ctx->survivor_count;
+    for (int r = 0; r < ctx->robot_count; r++) {
+        if (c->missions[r].survivor_count > 0) continue;
+        
+        int donor = -1;
+        for (int d = 0; d < ctx->robot_count; d++) {
+            if (c->missions[d].survivor_count > 1 &&
+                (donor < 0 || c->missions[d].survivor_count > c->missions[donor].survivor_count)) {
+                donor = d;
+            }
+        }
+        if (donor < 0) return;
+        
+        RobotMission *from = &c->missions[donor];
+        int best = 0;
+        for (int s = 1; s < from->survivor_count; s++) {
+            int a = from->survivor_sequence[s], b = from->survivor_sequence[best];
+            if (value[r * n + a] - value[donor * n + a] > value[r * n + b] - value[donor * n + b]) {
+                best = s;
+            }
+        }
+        assign(c, r, from->survivor_sequence[best]);
+        from->survivor_sequence[best] = from->survivor_sequence[--from->survivor_count];
+        from->survivor_sequence[from->survivor_count] = -1;
+    }
+}
+
+void seed_heuristic(Chromosome *c, SeedStrategy strategy, const SeedContext *ctx,
+                    int perturb, Rng *rng) {
+    int n = ctx->survivor_count;
+    int robots = ctx->robot_count;
+    size_t cells = (size_t)robots * n;
+    
+    clear_chromosome(c, ctx);
+    if (n == 0) return;
+    
+    double *value = malloc(cells * sizeof(double));
+    double *angle = malloc((n + robots) * sizeof(double));
+    int *order = malloc((n + robots) * sizeof(int));
+    if (!value || !angle || !order) {
+        fprintf(stderr, "Heuristic seeding: out of memory\n");
+        free(value);
+        free(angle);
+        free(order);
+        return;
+    }
+    
+    memcpy(value, ctx->value, cells * sizeof(double));
+    if (perturb) {
+        for (size_t i = 0; i < cells; i++) {
+            value[i] += ctx->noise * (rng_uniform(rng) - 0.5);
+        }
+    }
+    
+    switch (strategy) {
+        case SEED_NEAREST: seed_nearest(c, ctx, value, order, rng); break;
+        case SEED_SWEEP:   seed_sweep(c, ctx, order, angle, perturb, rng); break;
+        case SEED_REGRET:  seed_regret(c, ctx, value, order); break;
+        default: break;
+    }
+    activate_idle_robots(c, ctx, value);
+    
+    free(value);
+    free(angle);
+    free(order);
+}
@@ -0,0 +1,334 @@
+#include "all_headers.h"
+
+// Chromosomes travel between the breeder and the evaluators through two
+// bounded FIFOs of pointers: pending (bred, not yet scored) and done.
+typedef struct {
+    Chromosome **items;
+    int capacity;
+    int head;
+    int count;
+} ChromosomeQueue;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t work_cv;     // pending gained an item or stop was set
+    pthread_cond_t done_cv;     // done gained an item
+    ChromosomeQueue pending;
+    ChromosomeQueue done;
+    int stop;
+    int robot_count;
+    const Config *cfg;
+    
+    int thread_count;
+    pthread_t *threads;
+    double *busy_seconds;       // per evaluator, for the utilization report
+} SteadyQueue;
+
+typedef struct {
+    SteadyQueue *queue;
+    int id;
+} EvaluatorArg;
+
+static void queue_push(ChromosomeQueue *q, Chromosome *c) {
+    q->items[(q->head + q->count) % q->capacity] = c;
+    q->count++;
+}
+
+static Chromosome *queue_pop(ChromosomeQueue *q) {
+    Chromosome *c = q->items[q->head];
+    q->head = (q->head + 1) % q->capacity;
+    q->count--;
+    return c;
+}
+
+static void *evaluator_main(void *arg) {
+    EvaluatorArg *ea = (EvaluatorArg *)arg;
+    SteadyQueue *sq = ea->queue;
+    double busy = 0.0;
+    
+    pthread_mutex_lock(&sq->lock);
+    for (;;) {
+        while (sq->pending.count == 0 && !sq->stop) {
+            pthread_cond_wait(&sq->work_cv, &sq->lock);
+        }
+        if (sq->pending.count == 0) break;
+        Chromosome *c = queue_pop(&sq->pending);
+        pthread_mutex_unlock(&sq->lock);
+        
+        double start = monotonic_seconds();
+        c->fitness = fitness_chromosome_cached(c, sq->robot_count, sq->cfg);
+        c->fitness_valid = 1;
+        busy += monotonic_seconds() - start;
+        
+        pthread_mutex_lock(&sq->lock);
+        queue_push(&sq->done, c);
+        pthread_cond_signal(&sq->done_cv);
+    }
+    sq->busy_seconds[ea->id] = busy;
+    pthread_mutex_unlock(&sq->lock);
+    
+    ga_release_thread_scratch();
+    return NULL;
+}
+
+static int steady_queue_start(SteadyQueue *sq, int thread_count, int capacity,
+                              int robot_count, const Config *cfg, EvaluatorArg *args) {
+    memset(sq, 0, sizeof(*sq));
+    sq->robot_count = robot_count;
+    sq->cfg = cfg;
+    sq->pending.items = malloc(capacity * sizeof(Chromosome *));
+    sq->done.items = malloc(capacity * sizeof(Chromosome *));
+    sq->threads = malloc(thread_count * sizeof(pthread_t));
+    sq->busy_seconds = calloc(thread_count, sizeof(double));
+    if (!sq->pending.items || !sq->done.items || !sq->threads || !sq->busy_seconds) {
+        free(sq->pending.items);
+        free(sq->done.items);
+        free(sq->threads);
+        free(sq->busy_seconds);
+        return -1;
+    }
+    sq->pending.capacity = capacity;
+    sq->done.capacity = capacity;
+    pthread_mutex_init(&sq->lock, NULL);
+    pthread_cond_init(&sq->work_cv, NULL);
+    pthread_cond_init(&sq->done_cv, NULL);
+    
+    for (int t = 0; t < thread_count; t++) {
+        args[t].queue = sq;
+        args[t].id = t;
+        if (pthread_create(&sq->threads[t], NULL, evaluator_main, &args[t]) != 0) {
+            perror("pthread_create (evaluator)");
+            break;
+        }
+        sq->thread_count++;
+    }
+    return sq->thread_count > 0 ? 0 : -1;
+}
+
+// Joins the evaluators and returns their total busy time
+static double steady_queue_stop(SteadyQueue *sq) {
+    pthread_mutex_lock(&sq->lock);
+    sq->stop = 1;
+    pthread_cond_broadcast(&sq->work_cv);
+    pthread_mutex_unlock(&sq->lock);
+    
+    double busy = 0.0;
+    for (int t = 0; t < sq->thread_count; t++) {
+        pthread_join(sq->threads[t], NULL);
+        busy += sq->busy_seconds[t];
+    }
+    pthread_mutex_destroy(&sq->lock);
+    pthread_cond_destroy(&sq->work_cv);
+    pthread_cond_destroy(&sq->done_cv);
+    free(sq->pending.items);
+    free(sq->done.items);
+    free(sq->threads);
+    free(sq->busy_seconds);
+    return busy;
+}
+
+static void submit(SteadyQueue *sq, Chromosome *c) {
+    pthread_mutex_lock(&sq->lock);
+    queue_push(&sq->pending, c);
+    pthread_cond_signal(&sq->work_cv);
+    pthread_mutex_unlock(&sq->lock);
+}
+
+// Block until at least one evaluation finishes, then take all finished ones
+static int collect(SteadyQueue *sq, Chromosome *out[]) {
+    int n = 0;
+    pthread_mutex_lock(&sq->lock);
+    while (sq->done.count == 0) {
+        pthread_cond_wait(&sq->done_cv, &sq->lock);
+    }
+    while (sq->done.count > 0) {
+        out[n++] = queue_pop(&sq->done);
+    }
+    pthread_mutex_unlock(&sq->lock);
+    return n;
+}
+
+// Replace the worst individual with a fitter child, keeping pop sorted.
+// Whole structs are swapped so the child's buffers stay owned by someone.
+static int replace_worst(Chromosome pop[], int pop_size, Chromosome *child) {
+    if (child->fitness <= pop[pop_size - 1].fitness) return 0;
+    
+    Chromosome temp = pop[pop_size - 1];
+    pop[pop_size - 1] = *child;
+    *child = temp;
+    for (int i = pop_size - 1; i > 0 && pop[i].fitness > pop[i - 1].fitness; i--) {
+        temp = pop[i];
+        pop[i] = pop[i - 1];
+        pop[i - 1] = temp;
+    }
+    return 1;
+}
+
+void evolve_steady_state(int generations, Chromosome pop[], int pop_size,
+                         int robot_count, double mutation_rate, int elitism_pct,
+                         const Node robot_starts[], const Survivor survivors[],
+                         int survivor_count, const Config *cfg, Rng *rng) {
+    if (!pop || pop_size < 2 || robot_count <= 0 || !cfg || !rng) return;
+    
+    // Same evaluation budget as the generational loop
+    int elite_count = (pop_size * elitism_pct) / 100;
+    if (elite_count < 1) elite_count = 1;
+    if (elite_count >= pop_size) elite_count = pop_size - 1;
+    int child_count = pop_size - elite_count;
+    long budget = (long)generations * child_count;
+    
+    int thread_count = cfg->pool_size > 0 ? cfg->pool_size : cpuset_available();
+    if (cfg->pool_max > 0 && thread_count > cfg->pool_max) thread_count = cfg->pool_max;
+    if (thread_count > child_count) thread_count = child_count;
+    // Two children per evaluator in flight keeps the queue from running dry
+    // while the breeder merges results
+    int in_flight = 2 * thread_count;
+    int capacity = in_flight > pop_size ? in_flight : pop_size;
+    
+    int max_surv = cfg->max_survivors_per_robot;
+    Chromosome *children = allocate_population(in_flight, robot_count, max_surv);
+    if (children && pop[0].tour && tour_attach(children, in_flight, pop[0].tour_length) != 0) {
+        free_population(children, in_flight, robot_count);
+        children = NULL;
+    }
+    Chromosome **finished = malloc(capacity * sizeof(Chromosome *));
+    Chromosome **free_children = malloc(in_flight * sizeof(Chromosome *));
+    EvaluatorArg *args = malloc(thread_count * sizeof(EvaluatorArg));
+    SteadyQueue sq;
+    
+    if (!children || !finished || !free_children || !args) {
+        fprintf(stderr, "Failed to allocate memory for steady-state evolution\n");
+        if (children) free_population(children, in_flight, robot_count);
+        free(finished);
+        free(free_children);
+        free(args);
+        return;
+    }
+    
+    // TIME_BUDGET_MS also covers the setup below
+    StopCriteria stop;
+    stop_criteria_init(&stop, cfg);
+    
+    // Build the fitness kernel's lazy tables before any evaluator runs
+    if (!pop[0].fitness_valid) {
+        pop[0].fitness = fitness_chromosome_cached(&pop[0], robot_count, cfg);
+        pop[0].fitness_valid = 1;
+    }
+    
+    if ((cfg->local_search != LOCAL_SEARCH_OFF || pop[0].tour) &&
+        cost_table_init(&pop[0], robot_count, survivor_count, cfg) != 0) {
+        fprintf(stderr, "Visit cost table unavailable: local search and tour split disabled\n");
+    }
+    
+    if (steady_queue_start(&sq, thread_count, capacity, robot_count, cfg, args) != 0) {
+        fprintf(stderr, "Failed to start evaluator threads\n");
+        free_population(children, in_flight, robot_count);
+        free(finished);
+        free(free_children);
+        free(args);
+        return;
+    }
+    
+    printf("Starting steady-state evolution: %ld evaluations (%d generations x %d children)\n",
+           budget, generations, child_count);
+    printf("Mutation rate: %.2f, Evaluator threads: %d\n", mutation_rate, sq.thread_count);
+    
+    double start_time = monotonic_seconds();
+    
+    // Initial population goes through the evaluators as well
+    int outstanding = 0;
+    for (int i = 0; i < pop_size; i++) {
+        if (!pop[i].fitness_valid) {
+            submit(&sq, &pop[i]);
+            outstanding++;
+        }
+    }
+    while (outstanding > 0) {
+        outstanding -= collect(&sq, finished);
+    }
+    sort_by_fitness(pop, pop_size);
+    fitness_refine_top(pop, pop_size, cfg->exact_top_k, elite_count, robot_count, cfg);
+    
+    double best_fitness = pop[0].fitness;
+    printf("Generation 0: Best fitness = %.2f\n", best_fitness);
+    ga_publish_best(&pop[0], 0);
+    stop_criteria_check(&stop, pop, pop_size, robot_count, 0);
+    
+    int free_count = in_flight;
+    for (int i = 0; i < in_flight; i++) {
+        free_children[i] = &children[i];
+    }
+    
+    long bred = 0;
+    long merged = 0;
+    long accepted = 0;
+    int parents[2];
+    
+    while (merged < budget) {
+        // Keep every free child buffer busy
+        while (free_count > 0 && bred < budget) {
+            Chromosome *child = free_children[--free_count];
+            tournament_select(pop, pop_size, parents, 2, rng);
+            // Without generations there are no elites; any mode improves children
+            breed_child(child, &pop[parents[0]], &pop[parents[1]], robot_count, survivor_count,
+                        mutation_rate, robot_starts, survivors, cfg,
+                        cfg->local_search != LOCAL_SEARCH_OFF, rng);
+            submit(&sq, child);
+            bred++;
+        }
+        
+        int n = collect(&sq, finished);
+        for (int k = 0; k < n; k++) {
+            if (replace_worst(pop, pop_size, finished[k])) {
+                accepted++;
+                ga_publish_best(&pop[0], (int)(merged / child_count));
+            }
+            free_children[free_count++] = finished[k];
+            merged++;
+            
+            // Once per generation's worth of evaluations, re-rank the
+            // leaders on exact path lengths and report
+            if (merged % child_count == 0) {
+                long gen = merged / child_count;
+                if (fitness_refine_top(pop, pop_size, cfg->exact_top_k, elite_count, robot_count, cfg) > 0) {
+                    ga_publish_best(&pop[0], (int)gen);
+                }
+                double current_best = pop[0].fitness;
+                double improvement = current_best - best_fitness;
+                if (gen % 25 == 0 || (improvement > 5.0 && current_best > best_fitness)) {
+                    printf("Generation %ld: Best fitness = %.2f", gen, current_best);
+                    if (improvement > 0.01) {
+                        printf(" (improvement: %.2f)", improvement);
+                    }
+                    printf(" [accepted %ld of %ld children]\n", accepted, merged);
+                    best_fitness = current_best;
+                }
+                
+                // On stop, breed nothing more and let in-flight children land
+                if (bred < budget) {
+                    const char *stop_reason = stop_criteria_check(&stop, pop, pop_size, robot_count, (int)gen);
+                    if (stop_reason) {
+                        printf("Stopping at generation %ld: %s (best = %.2f)\n", gen, stop_reason, current_best);
+                        budget = bred;
+                    }
+                }
+            }
+        }
+    }
+    
+    double wall = monotonic_seconds() - start_time;
+    int threads_used = sq.thread_count;
+    double busy = steady_queue_stop(&sq);
+    stop_criteria_free(&stop);
+    
+    printf("Evolution complete. Final best fitness = %.2f\n", pop[0].fitness);
+    if (wall > 0.0) {
+        printf("Evaluator utilization: %.1f%% over %.2f s\n",
+               100.0 * busy / (wall * threads_used), wall);
+    }
+    
+    free_population(children, in_flight, robot_count);
+    free(finished);
+    free(free_children);
+    free(args);
+}
@@ -0,0 +1,214 @@
+#include "all_headers.h"
+
+// Chunks [head, tail) still owned by one thread. The owner pops from the
+// tail and thieves take from the head, so they meet only on the last chunk.
+typedef struct {
+    pthread_mutex_t lock;
+    int head;
+    int tail;
+} WorkDeque;
+
+typedef struct {
+    ThreadPool *pool;
+    int id;
+    pthread_t thread;
+} PoolWorker;
+
+struct ThreadPool {
+    int size;                   // threads including the caller
+    PoolWorker *workers;        // [1..size-1] are started threads
+    WorkDeque *deques;          // one per thread, [0] is the caller's
+    
+    pthread_mutex_t lock;
+    pthread_cond_t work_cv;
+    pthread_cond_t done_cv;
+    unsigned long round;        // bumped once per thread_pool_run
+    int busy;                   // workers still inside the current round
+    int stop;
+    
+    // Current loop
+    ThreadPoolTask task;
+    void *arg;
+    int count;
+    int grain;
+};
+
+static int deque_pop_back(WorkDeque *dq, int *chunk) {
+    int found = 0;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->head < dq->tail) {
+        *chunk = --dq->tail;
+        found = 1;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return found;
+}
+
+static int deque_steal_front(WorkDeque *dq, int *chunk) {
+    int found = 0;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->head < dq->tail) {
+        *chunk = dq->head++;
+        found = 1;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return found;
+}
+
+static void run_chunk(ThreadPool *pool, int chunk) {
+    int begin = chunk * pool->grain;
+    int end = begin + pool->grain;
+    if (end > pool->count) end = pool->count;
+    pool->task(pool->arg, begin, end);
+}
+
+// Work through our own deque, then steal until a full sweep finds nothing.
+// Chunks are never added during a round, so an empty sweep means done.
+static void work_round(ThreadPool *pool, int id) {
+    int chunk;
+    while (deque_pop_back(&pool->deques[id], &chunk)) {
+        run_chunk(pool, chunk);
+    }
+    
+    for (;;) {
+        int stolen = 0;
+        for (int k = 1; k < pool->size; k++) {
+            int victim = (id + k) % pool->size;
+            if (deque_steal_front(&pool->deques[victim], &chunk)) {
+                run_chunk(pool, chunk);
+                stolen = 1;
+                break;
+            }
+        }
+        if (!stolen) return;
+    }
+}
+
+static void *pool_thread_main(void *arg) {
+    PoolWorker *worker = arg;
+    ThreadPool *pool = worker->pool;
+    unsigned long seen = 0;
+    
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->stop && pool->round == seen) {
+            pthread_cond_wait(&pool->work_cv, &pool->lock);
+        }
+        if (pool->stop) {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        seen = pool->round;
+        pthread_mutex_unlock(&pool->lock);
+        
+        work_round(pool, worker->id);
+        
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busy == 0) {
+            pthread_cond_signal(&pool->done_cv);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+    
+    ga_release_thread_scratch();
+    return NULL;
+}
+
+ThreadPool *thread_pool_create(int threads) {
+    if (threads < 1) threads = 1;
+    
+    ThreadPool *pool = calloc(1, sizeof(ThreadPool));
+    if (!pool) return NULL;
+    pool->workers = calloc(threads, sizeof(PoolWorker));
+    pool->deques = calloc(threads, sizeof(WorkDeque));
+    if (!pool->workers || !pool->deques) {
+        free(pool->workers);
+        free(pool->deques);
+        free(pool);
+        return NULL;
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_mutex_init(&pool->deques[t].lock, NULL);
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_cv, NULL);
+    pthread_cond_init(&pool->done_cv, NULL);
+    
+    // Thread 0 is the caller of thread_pool_run
+    pool->size = 1;
+    for (int t = 1; t < threads; t++) {
+        PoolWorker *worker = &pool->workers[t];
+        worker->pool = pool;
+        worker->id = t;
+        if (pthread_create(&worker->thread, NULL, pool_thread_main, worker) != 0) {
+            fprintf(stderr, "Warning: started only %d of %d pool threads\n", t, threads);
+            break;
+        }
+        pool->size++;
+    }
+    return pool;
+}
+
+void thread_pool_destroy(ThreadPool *pool) {
+    if (!pool) return;
+    
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->work_cv);
+    pthread_mutex_unlock(&pool->lock);
+    
+    for (int t = 1; t < pool->size; t++) {
+        pthread_join(pool->workers[t].thread, NULL);
+    }
+    for (int t = 0; t < pool->size; t++) {
+        pthread_mutex_destroy(&pool->deques[t].lock);
+    }
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->work_cv);
+    pthread_cond_destroy(&pool->done_cv);
+    free(pool->workers);
+    free(pool->deques);
+    free(pool);
+}
+
+int thread_pool_size(const ThreadPool *pool) {
+    return pool ? pool->size : 0;
+}
+
+void thread_pool_run(ThreadPool *pool, int count, int grain, ThreadPoolTask task, void *arg) {
+    if (count <= 0) return;
+    if (grain <= 0) {
+        // A few chunks per thread leave room for stealing
+        grain = count / (pool->size * 4);
+        if (grain < 1) grain = 1;
+    }
+    int chunks = (count + grain - 1) / grain;
+    
+    pool->task = task;
+    pool->arg = arg;
+    pool->count = count;
+    pool->grain = grain;
+    
+    // Each thread starts with a contiguous run of chunks
+    for (int t = 0; t < pool->size; t++) {
+        WorkDeque *dq = &pool->deques[t];
+        pthread_mutex_lock(&dq->lock);
+        dq->head = (int)((long)chunks * t / pool->size);
+        dq->tail = (int)((long)chunks * (t + 1) / pool->size);
+        pthread_mutex_unlock(&dq->lock);
+    }
+    
+    pthread_mutex_lock(&pool->lock);
+    pool->round++;
+    pool->busy = pool->size - 1;
+    pthread_cond_broadcast(&pool->work_cv);
+    pthread_mutex_unlock(&pool->lock);
+    
+    work_round(pool, 0);
+    
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busy > 0) {
+        pthread_cond_wait(&pool->done_cv, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
@@ -0,0 +1,254 @@
+#include "all_headers.h"
+
+// Per-thread buffers for split and crossover
+typedef struct {
+    double *best_prev;      // best value with the tour prefix [0, j) assigned so far
+    double *best_next;
+    double *prefix;         // prefix sums of the current robot's visit values
+    int *window;            // sliding-window deque of cut positions
+    int *cut;               // [r * (n + 1) + j]: where robot r's segment ends at j starts
+    unsigned int *stamp;    // OX membership, epoch-stamped
+    unsigned int epoch;
+    int capacity;           // survivors the buffers hold
+    int robot_capacity;
+} TourScratch;
+
+static __thread TourScratch tour_scratch = {0};
+
+void tour_release_thread_scratch(void) {
+    free(tour_scratch.best_prev);
+    free(tour_scratch.best_next);
+    free(tour_scratch.prefix);
+    free(tour_scratch.window);
+    free(tour_scratch.cut);
+    free(tour_scratch.stamp);
+    tour_scratch = (TourScratch){0};
+}
+
+static int tour_scratch_reserve(TourScratch *ts, int n, int robot_count) {
+    if (n > ts->capacity || robot_count > ts->robot_capacity) {
+        int cap = n > ts->capacity ? n : ts->capacity;
+        int robots = robot_count > ts->robot_capacity ? robot_count : ts->robot_capacity;
+        tour_release_thread_scratch();
+        ts->best_prev = malloc((cap + 1) * sizeof(double));
+        ts->best_next = malloc((cap + 1) * sizeof(double));
+        ts->prefix = malloc((cap + 1) * sizeof(double));
+        ts->window = malloc((cap + 1) * sizeof(int));
+        ts->cut = malloc((size_t)robots * (cap + 1) * sizeof(int));
+        ts->stamp = calloc(cap, sizeof(unsigned int));
+        if (!ts->best_prev || !ts->best_next || !ts->prefix || !ts->window || !ts->cut || !ts->stamp) {
+            tour_release_thread_scratch();
+            return -1;
+        }
+        ts->capacity = cap;
+        ts->robot_capacity = robots;
+    }
+    return 0;
+}
+
+static unsigned int next_epoch(TourScratch *ts) {
+    if (++ts->epoch == 0) {
+        memset(ts->stamp, 0, ts->capacity * sizeof(unsigned int));
+        ts->epoch = 1;
+    }
+    return ts->epoch;
+}
+
+int tour_attach(Chromosome pop[], int pop_size, int survivor_count) {
+    for (int i = 0; i < pop_size; i++) {
+        pop[i].tour = malloc((survivor_count > 0 ? survivor_count : 1) * sizeof(int));
+        if (!pop[i].tour) {
+            fprintf(stderr, "Failed to allocate giant tours\n");
+            return -1;
+        }
+        pop[i].tour_length = survivor_count;
+        for (int k = 0; k < survivor_count; k++) {
+            pop[i].tour[k] = k;
+        }
+    }
+    return 0;
+}
+
+void tour_detach(Chromosome pop[], int pop_size) {
+    for (int i = 0; i < pop_size; i++) {
+        free(pop[i].tour);
+        pop[i].tour = NULL;
+        pop[i].tour_length = 0;
+    }
+}
+
+void tour_from_missions(Chromosome *c, int robot_count) {
+    int n = c->tour_length;
+    TourScratch *ts = &tour_scratch;
+    if (!c->tour || tour_scratch_reserve(ts, n, robot_count) != 0) return;
+    unsigned int epoch = next_epoch(ts);
+    
+    int k = 0;
+    for (int r = 0; r < robot_count; r++) {
+        const RobotMission *mission = &c->missions[r];
+        for (int s = 0; s < mission->survivor_count && k < n; s++) {
+            int sid = mission->survivor_sequence[s];
+            if (sid >= 0 && sid < n && ts->stamp[sid] != epoch) {
+                ts->stamp[sid] = epoch;
+                c->tour[k++] = sid;
+            }
+        }
+    }
+    for (int sid = 0; sid < n; sid++) {
+        if (ts->stamp[sid] != epoch) c->tour[k++] = sid;
+    }
+}
+
+int tour_split(Chromosome *c, int robot_count, const Config *cfg) {
+    const CostTable *ct = cost_table_get();
+    int n = c->tour_length;
+    if (!c->tour || !cost_table_matches(ct, c, robot_count) || n > ct->survivor_count) return -1;
+    
+    TourScratch *ts = &tour_scratch;
+    if (tour_scratch_reserve(ts, n, robot_count) != 0) return -1;
+    
+    int capacity = cfg->max_survivors_per_robot;
+    int min_segment = n >= robot_count ? 1 : 0;
+    long assignable = (long)robot_count * capacity;
+    int target = n < assignable ? n : (int)assignable;
+    
+    double *best_prev = ts->best_prev;
+    double *best_next = ts->best_next;
+    double *prefix = ts->prefix;
+    int *window = ts->window;
+    
+    best_prev[0] = 0.0;
+    for (int j = 1; j <= target; j++) best_prev[j] = -INFINITY;
+    
+    // best_next[j] = prefix[j] + max over cuts i in [j - capacity, j - min_segment]
+    // of best_prev[i] - prefix[i]; a monotone deque keeps that maximum
+    for (int r = 0; r < robot_count; r++) {
+        const double *row = &ct->value[(size_t)r * ct->survivor_count];
+        int *cut = &ts->cut[(size_t)r * (n + 1)];
+        
+        prefix[0] = 0.0;
+        for (int j = 0; j < target; j++) {
+            prefix[j + 1] = prefix[j] + row[c->tour[j]];
+        }
+        
+        int head = 0, tail = 0;
+        for (int j = 0; j <= target; j++) {
+            int enter = j - min_segment;
+            if (enter >= 0) {
+                double key = best_prev[enter] - prefix[enter];
+                while (tail > head && best_prev[window[tail - 1]] - prefix[window[tail - 1]] <= key) tail--;
+                window[tail++] = enter;
+            }
+            while (tail > head && window[head] < j - capacity) head++;
+            
+            if (tail > head) {
+                int i = window[head];
+                best_next[j] = prefix[j] + best_prev[i] - prefix[i];
+                cut[j] = i;
+            } else {
+                best_next[j] = -INFINITY;
+                cut[j] = -1;
+            }
+        }
+        
+        double *swap = best_prev;
+        best_prev = best_next;
+        best_next = swap;
+    }
+    if (best_prev[target] == -INFINITY) return -1;
+    
+    // Walk the cuts back from the last robot and rewrite changed missions
+    int changed = 0;
+    int end = target;
+    for (int r = robot_count - 1; r >= 0; r--) {
+        int begin = ts->cut[(size_t)r * (n + 1) + end];
+        RobotMission *mission = &c->missions[r];
+        int count = end - begin;
+        int same = mission->survivor_count == count;
+        for (int s = 0; s < count && same; s++) {
+            same = mission->survivor_sequence[s] == c->tour[begin + s];
+        }
+        if (!same) {
+            memcpy(mission->survivor_sequence, &c->tour[begin], count * sizeof(int));
+            for (int s = count; s < capacity; s++) {
+                mission->survivor_sequence[s] = -1;
+            }
+            mission->survivor_count = count;
+            if (c->scores) c->scores[r].dirty = 1;
+            changed = 1;
+        }
+        end = begin;
+    }
+    
+    if (changed) {
+        c->fitness = 0.0;
+        c->fitness_valid = 0;
+    }
+    return 0;
+}
+
+void tour_crossover(Chromosome *child, const Chromosome *p1, const Chromosome *p2, Rng *rng) {
+    int n = p1->tour_length;
+    TourScratch *ts = &tour_scratch;
+    if (n <= 0 || tour_scratch_reserve(ts, n, 1) != 0) return;
+    unsigned int epoch = next_epoch(ts);
+    
+    int a = rng_below(rng, n);
+    int b = rng_below(rng, n);
+    if (a > b) { int t = a; a = b; b = t; }
+    
+    for (int k = a; k <= b; k++) {
+        child->tour[k] = p1->tour[k];
+        ts->stamp[p1->tour[k]] = epoch;
+    }
+    
+    // Remaining positions, after the slice and wrapping, in p2's order
+    int out = (b + 1) % n;
+    for (int k = 0; k < n; k++) {
+        int sid = p2->tour[(b + 1 + k) % n];
+        if (ts->stamp[sid] == epoch) continue;
+        child->tour[out] = sid;
+        out = (out + 1) % n;
+    }
+    child->tour_length = n;
+    child->fitness = 0.0;
+    child->fitness_valid = 0;
+}
+
+void tour_mutate(Chromosome *c, int robot_count, double rate, Rng *rng) {
+    int n = c->tour_length;
+    if (n < 2) return;
+    
+    for (int trial = 0; trial < robot_count; trial++) {
+        if (rng_uniform(rng) >= rate) continue;
+        
+        int i = rng_below(rng, n);
+        int j = rng_below(rng, n);
+        int kind = rng_below(rng, 3);
+        if (kind == 0) {
+            // Swap two survivors
+            int t = c->tour[i];
+            c->tour[i] = c->tour[j];
+            c->tour[j] = t;
+        } else if (kind == 1) {
+            // Reverse a section
+            if (i > j) { int t = i; i = j; j = t; }
+            while (i < j) {
+                int t = c->tour[i];
+                c->tour[i++] = c->tour[j];
+                c->tour[j--] = t;
+            }
+        } else {
+            // Move one survivor to another position
+            int sid = c->tour[i];
+            if (i < j) {
+                memmove(&c->tour[i], &c->tour[i + 1], (j - i) * sizeof(int));
+            } else if (i > j) {
+                memmove(&c->tour[j + 1], &c->tour[j], (i - j) * sizeof(int));
+            }
+            c->tour[j] = sid;
+        }
+    }
+    c->fitness = 0.0;
+    c->fitness_valid = 0;
+}